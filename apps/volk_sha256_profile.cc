@@ -26,16 +26,28 @@
 
 #include <volk_sha256/volk_sha256.h>
 #include <volk_sha256/volk_sha256_prefs.h>
+#include <volk_sha256/volk_sha256_prefetch.h>
+#include <volk_sha256/volk_sha256_pbkdf2.h>
 
 #include <ciso646>
 #include <vector>
+#include <map>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include <boost/xpressive/xpressive.hpp>
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <ctime>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <elf.h>
+#endif
 
 namespace fs = boost::filesystem;
 
@@ -71,6 +83,27 @@ int main(int argc, char *argv[]) {
       ("json,j",
             boost::program_options::value<std::string>(),
             "JSON output file")
+      ("alignment-gap,A",
+            boost::program_options::value<bool>()->default_value( false )
+                                                     ->implicit_value( true ),
+            "Report the gap between aligned and unaligned buffers of the hash kernel")
+      ("short-latency,S",
+            boost::program_options::value<bool>()->default_value( false )
+                                                     ->implicit_value( true ),
+            "Report the ns per call of the short message kernel")
+      ("large-input,L",
+            boost::program_options::value<int>()->default_value( 0 ),
+            "Hash a sparse mapping of this many GiB with every 64 bit length kernel implementation")
+      ("prefetch-distance,P",
+            boost::program_options::value<int>()->default_value( 0 ),
+            "Tune the prefetch distance of the large input implementations on a buffer of this many MiB")
+      ("pbkdf2,K",
+            boost::program_options::value<int>()->default_value( 0 ),
+            "Report the derivations per second of every PBKDF2 implementation with this many iterations")
+      ("code-size,z",
+            boost::program_options::value<bool>()->default_value( false )
+                                                     ->implicit_value( true ),
+            "Report the code size of each implementation of the tested kernels")
       ;
 
     // Handle the options that were given
@@ -86,6 +119,12 @@ int main(int argc, char *argv[]) {
     std::string def_kernel_regex;
     bool update_mode = false;
     bool dry_run = false;
+    bool alignment_gap = false;
+    bool short_latency = false;
+    int large_input_gib = 0;
+    int prefetch_mib = 0;
+    int pbkdf2_iterations = 0;
+    bool code_size = false;
 
     // Handle the provided options
     try {
@@ -107,6 +146,12 @@ int main(int argc, char *argv[]) {
         def_kernel_regex = kernel_regex;
         update_mode = vm["update"].as<bool>();
         dry_run = vm["dry-run"].as<bool>();
+        alignment_gap = vm["alignment-gap"].as<bool>();
+        short_latency = vm["short-latency"].as<bool>();
+        large_input_gib = vm["large-input"].as<int>();
+        prefetch_mib = vm["prefetch-distance"].as<int>();
+        pbkdf2_iterations = vm["pbkdf2"].as<int>();
+        code_size = vm["code-size"].as<bool>();
     }
     catch (boost::program_options::error& error) {
         std::cerr << "Error: " << error.what() << std::endl << std::endl;
@@ -138,8 +183,9 @@ int main(int argc, char *argv[]) {
 
     // Run tests
     std::vector<volk_sha256_test_results_t> results;
+    int prefetch_distance = -1; // no prefetch_distance line unless tuned or kept from the config
     if(update_mode) {
-        read_results(&results);
+        read_results(&results, &prefetch_distance);
     }
 
 
@@ -190,10 +236,33 @@ int main(int argc, char *argv[]) {
                 std::cerr << "Caught Exception in 'run_volk_sha256_tests': " << error << std::endl;
             }
 
+            if(code_size) {
+                run_code_size(test_case.name(), test_case.desc());
+            }
         }
     }
 
 
+    if(alignment_gap) {
+        run_alignment_gap(def_vlen, def_iter);
+    }
+
+    if(short_latency) {
+        run_short_latency(def_iter);
+    }
+
+    if(large_input_gib > 0) {
+        run_large_input(large_input_gib);
+    }
+
+    if(prefetch_mib > 0) {
+        run_prefetch_distance(prefetch_mib, &prefetch_distance);
+    }
+
+    if(pbkdf2_iterations > 0) {
+        run_pbkdf2(pbkdf2_iterations);
+    }
+
     // Output results according to provided options
     if(vm.count("json")) {
         write_json(json_file, results);
@@ -201,14 +270,311 @@ int main(int argc, char *argv[]) {
     }
 
     if(!dry_run) {
-        write_results(&results, false);
+        write_results(&results, false, prefetch_distance);
     }
     else {
         std::cout << "Warning: this was a dry-run. Config not generated" << std::endl;
     }
 }
 
-void read_results(std::vector<volk_sha256_test_results_t> *results)
+double time_hash(const char *impl_name, const uint8_t *msg, unsigned int vlen, unsigned int iter)
+{
+    uint32_t hash[8];
+    clock_t start = clock();
+    for(unsigned int i = 0; i < iter; i++) {
+        if(impl_name) {
+            volk_sha256_8u_hash_32u_manual(hash, msg, vlen, impl_name);
+        }
+        else {
+            volk_sha256_8u_hash_32u(hash, msg, vlen);
+        }
+    }
+    clock_t end = clock();
+    return 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
+}
+
+void run_alignment_gap(unsigned int vlen, unsigned int iter)
+{
+    // Offsets of 1 and 4 bytes are the typical starts of payloads in network and file buffers
+    const size_t alignment = volk_sha256_get_alignment();
+    uint8_t *buffer = (uint8_t *)volk_sha256_malloc(vlen + alignment, alignment);
+    for(unsigned int i = 0; i < vlen + alignment; i++) {
+        buffer[i] = (uint8_t)rand();
+    }
+
+    std::cout << "RUN_ALIGNMENT_GAP: volk_sha256_8u_hash_32u(" << vlen << "," << iter << ")" << std::endl;
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash_32u_get_func_desc();
+    for(size_t i = 0; i < desc.n_impls; i++) {
+        const double time_aligned = time_hash(desc.impl_names[i], buffer, vlen, iter);
+        std::cout << desc.impl_names[i] << " aligned: " << time_aligned << "ms";
+        if(!desc.impl_alignment[i]) {
+            const double time_offset1 = time_hash(desc.impl_names[i], buffer + 1, vlen, iter);
+            const double time_offset4 = time_hash(desc.impl_names[i], buffer + 4, vlen, iter);
+            std::cout << ", offset 1: " << time_offset1 << "ms"
+                      << ", offset 4: " << time_offset4 << "ms";
+        }
+        std::cout << std::endl;
+    }
+
+    // The dispatcher routes the unaligned buffers to the best _u implementation
+    const double time_aligned = time_hash(NULL, buffer, vlen, iter);
+    const double time_unaligned = time_hash(NULL, buffer + 1, vlen, iter);
+    std::cout << "dispatcher aligned: " << time_aligned << "ms, unaligned: " << time_unaligned
+              << "ms, gap: " << 100.0 * (time_unaligned - time_aligned) / time_aligned << "%" << std::endl;
+
+    volk_sha256_free(buffer);
+}
+
+void run_short_latency(unsigned int iter)
+{
+    // Lengths of typical keys, the last one is the longest message fitting one block
+    const unsigned int lens[3] = {16, 32, 55};
+    const unsigned int calls = 1000 * iter;
+    __VOLK_ATTR_ALIGNED(64) uint8_t msg[64];
+    uint32_t hash[8];
+    for(unsigned int i = 0; i < 64; i++) {
+        msg[i] = (uint8_t)rand();
+    }
+
+    std::cout << "RUN_SHORT_LATENCY: volk_sha256_8u_hash_short_32u(" << calls << ")" << std::endl;
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash_short_32u_get_func_desc();
+    for(size_t i = 0; i < desc.n_impls + 2; i++) {
+        // The implementations are called by name, the last two rows go through the dispatchers of
+        // the short message kernel and of the general hash kernel for comparison
+        if(i < desc.n_impls) std::cout << desc.impl_names[i];
+        else if(i == desc.n_impls) std::cout << "volk_sha256_8u_hash_short_32u";
+        else std::cout << "volk_sha256_8u_hash_32u";
+        for(size_t j = 0; j < 3; j++) {
+            clock_t start = clock();
+            for(unsigned int k = 0; k < calls; k++) {
+                if(i < desc.n_impls) {
+                    volk_sha256_8u_hash_short_32u_manual(hash, msg, lens[j], desc.impl_names[i]);
+                }
+                else if(i == desc.n_impls) {
+                    volk_sha256_8u_hash_short_32u(hash, msg, lens[j]);
+                }
+                else {
+                    volk_sha256_8u_hash_32u(hash, msg, lens[j]);
+                }
+            }
+            clock_t end = clock();
+            std::cout << ((j == 0) ? " " : ", ") << lens[j] << " bytes: "
+                      << 1e9 * (double)(end-start)/(double)CLOCKS_PER_SEC / calls << "ns/call";
+        }
+        std::cout << std::endl;
+    }
+}
+
+void run_large_input(int gib)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    // An anonymous mapping is never written, so all pages read back as the shared zero page
+    const uint64_t msg_len = (uint64_t)gib << 30;
+    void *mapping = mmap(NULL, msg_len, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(mapping == MAP_FAILED) {
+        std::cerr << "Error: unable to map " << gib << " GiB for the large input test" << std::endl;
+        return;
+    }
+    const uint8_t *msg = (const uint8_t *)mapping;
+
+    std::cout << "RUN_LARGE_INPUT: volk_sha256_8u_hash64_32u(" << msg_len << ")" << std::endl;
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash64_32u_get_func_desc();
+    uint32_t ref_hash[8], hash[8];
+    volk_sha256_8u_hash64_32u_manual(ref_hash, msg, msg_len, "generic");
+    for(size_t i = 0; i < desc.n_impls; i++) {
+        clock_t start = clock();
+        volk_sha256_8u_hash64_32u_manual(hash, msg, msg_len, desc.impl_names[i]);
+        clock_t end = clock();
+        double arch_time = 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
+        std::cout << desc.impl_names[i] << " completed in " << arch_time << "ms ("
+                  << (double)msg_len / (arch_time * 1e6) << " GB/s)";
+        if(memcmp(hash, ref_hash, sizeof(hash))) {
+            std::cout << " fail (does not match generic)";
+        }
+        std::cout << std::endl;
+    }
+    munmap(mapping, msg_len);
+#else
+    std::cerr << "Warning: the large input test needs mmap, skipped" << std::endl;
+#endif
+}
+
+void run_prefetch_distance(int mib, int *prefetch_distance)
+{
+    // The buffer is written, the zero page behind the sparse mapping of the large input test never misses the cache
+    const uint64_t msg_len = (uint64_t)mib << 20;
+    uint8_t *msg = (uint8_t *)volk_sha256_malloc(msg_len, volk_sha256_get_alignment());
+    if(!msg) {
+        std::cerr << "Error: unable to allocate " << mib << " MiB for the prefetch distance test" << std::endl;
+        return;
+    }
+    for(uint64_t k = 0; k < msg_len; k++) msg[k] = (uint8_t)(k*3 + 7);
+
+    const unsigned int distances[] = {0, 512, 1024, 2048, 4096, 8192, 16384, 32768};
+    const size_t n_distances = sizeof(distances)/sizeof(distances[0]);
+    unsigned int best_distance = volk_sha256_get_prefetch_distance();
+    double best_time = -1.0;
+    uint32_t hash[8];
+
+    std::cout << "RUN_PREFETCH_DISTANCE: volk_sha256_8u_hash64_32u(" << msg_len << ")" << std::endl;
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash64_32u_get_func_desc();
+    for(size_t i = 0; i < desc.n_impls; i++) {
+        if(!strstr(desc.impl_names[i], "_prefetch")) continue;
+        std::cout << desc.impl_names[i] << ":";
+        for(size_t j = 0; j < n_distances; j++) {
+            // Best of three passes, each pass streams the whole buffer from memory
+            volk_sha256_set_prefetch_distance(distances[j]);
+            double arch_time = -1.0;
+            for(int pass = 0; pass < 3; pass++) {
+                clock_t start = clock();
+                volk_sha256_8u_hash64_32u_manual(hash, msg, msg_len, desc.impl_names[i]);
+                clock_t end = clock();
+                double pass_time = 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
+                if(arch_time < 0 || pass_time < arch_time) arch_time = pass_time;
+            }
+            std::cout << ((j == 0) ? " " : ", ") << distances[j] << " bytes: "
+                      << (double)msg_len / (arch_time * 1e6) << " GB/s";
+            if(best_time < 0 || arch_time < best_time) {
+                best_time = arch_time;
+                best_distance = distances[j];
+            }
+        }
+        std::cout << std::endl;
+    }
+    volk_sha256_free(msg);
+
+    if(best_time < 0) {
+        std::cerr << "Warning: no prefetch implementation on this machine, distance not tuned" << std::endl;
+        return;
+    }
+    std::cout << "Best prefetch distance: " << best_distance << " bytes" << std::endl;
+    volk_sha256_set_prefetch_distance(best_distance);
+    *prefetch_distance = (int)best_distance;
+}
+
+void run_pbkdf2(unsigned int iterations)
+{
+    // A login burst of independent passwords with one output block each
+    const unsigned int count = 64;
+    const unsigned int dk_len = 32;
+    std::vector<volk_sha256_hmac_key_t> keys(count);
+    std::vector<const volk_sha256_hmac_key_t*> key_ptrs(count);
+    std::vector<const uint32_t*> key_states(count);
+    std::vector<const uint8_t*> salts(count);
+    std::vector<unsigned int> salt_lens(count, 16);
+    std::vector<uint8_t> passwords(16*count), salt_bytes(16*count);
+    std::vector<uint8_t> ref_dk(dk_len*count), dk(dk_len*count);
+    for(unsigned int k = 0; k < 16*count; k++) {
+        passwords[k] = (uint8_t)(k*5 + 1);
+        salt_bytes[k] = (uint8_t)(k*3 + 7);
+    }
+    for(unsigned int k = 0; k < count; k++) {
+        volk_sha256_hmac_key_init(&keys[k], &passwords[16*k], 16);
+        key_ptrs[k] = &keys[k];
+        key_states[k] = keys[k].state;
+        salts[k] = &salt_bytes[16*k];
+    }
+
+    std::cout << "RUN_PBKDF2: volk_sha256_8u_pbkdf2_8u(" << count << " passwords, "
+              << iterations << " iterations)" << std::endl;
+    volk_sha256_func_desc_t desc = volk_sha256_8u_pbkdf2_8u_get_func_desc();
+    volk_sha256_8u_pbkdf2_8u_manual(&ref_dk[0], &key_states[0], &salts[0], &salt_lens[0], iterations, dk_len, count, "generic");
+    for(size_t i = 0; i <= desc.n_impls; i++) {
+        // The last pass runs the batch API with the dispatched implementation
+        clock_t start = clock();
+        if(i < desc.n_impls) {
+            volk_sha256_8u_pbkdf2_8u_manual(&dk[0], &key_states[0], &salts[0], &salt_lens[0], iterations, dk_len, count,
+                                            desc.impl_names[i]);
+        }
+        else {
+            volk_sha256_pbkdf2_batch(&dk[0], dk_len, &key_ptrs[0], &salts[0], &salt_lens[0], iterations, count);
+        }
+        clock_t end = clock();
+        double arch_time = 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
+        std::cout << ((i < desc.n_impls) ? desc.impl_names[i] : "volk_sha256_pbkdf2_batch") << " completed in "
+                  << arch_time << "ms (" << 1000.0 * count / arch_time << " derivations/s)";
+        if(memcmp(&dk[0], &ref_dk[0], dk_len*count)) {
+            std::cout << " fail (does not match generic)";
+        }
+        std::cout << std::endl;
+    }
+
+    // A single password with a 256 byte key runs its eight output blocks on the lanes
+    const unsigned int long_dk_len = 256;
+    std::vector<uint8_t> long_dk(long_dk_len);
+    clock_t start = clock();
+    volk_sha256_pbkdf2(&long_dk[0], long_dk_len, &passwords[0], 16, &salt_bytes[0], 16, iterations);
+    clock_t end = clock();
+    double arch_time = 1000.0 * (double)(end-start)/(double)CLOCKS_PER_SEC;
+    std::cout << "volk_sha256_pbkdf2(" << long_dk_len << " byte key) completed in " << arch_time << "ms ("
+              << 1000.0 / arch_time << " derivations/s)" << std::endl;
+}
+
+#if defined(__linux__)
+// Sum the symbol sizes of the implementations and their out of line block functions in the
+// translation unit of the machine in use and in the assembly, the ELF symbol table lists locals
+// per source file
+static std::map<std::string, size_t> read_machine_symbol_sizes(const std::string &machine_file)
+{
+    std::map<std::string, size_t> sizes;
+    Dl_info info;
+    if(!dladdr((void *)&volk_sha256_get_machine, &info) || !info.dli_fname) return sizes;
+
+    std::ifstream lib_file(info.dli_fname, std::ios::binary);
+    std::vector<char> image((std::istreambuf_iterator<char>(lib_file)), std::istreambuf_iterator<char>());
+    if(image.size() < sizeof(Elf64_Ehdr) || image[EI_CLASS] != ELFCLASS64) return sizes;
+    const Elf64_Ehdr *ehdr = (const Elf64_Ehdr *)&image[0];
+    if(ehdr->e_shoff + ehdr->e_shnum * sizeof(Elf64_Shdr) > image.size()) return sizes;
+    const Elf64_Shdr *shdrs = (const Elf64_Shdr *)&image[ehdr->e_shoff];
+
+    for(size_t i = 0; i < ehdr->e_shnum; i++) {
+        if(shdrs[i].sh_type != SHT_SYMTAB) continue; // stripped libraries have none
+        const Elf64_Sym *syms = (const Elf64_Sym *)&image[shdrs[i].sh_offset];
+        const char *strtab = &image[shdrs[shdrs[i].sh_link].sh_offset];
+        const size_t n_syms = shdrs[i].sh_size / sizeof(Elf64_Sym);
+        bool in_machine = false, in_other_machine = false;
+        for(size_t j = 0; j < n_syms; j++) {
+            std::string name = strtab + syms[j].st_name;
+            if(ELF64_ST_TYPE(syms[j].st_info) == STT_FILE) {
+                in_machine = (name == machine_file);
+                in_other_machine = !in_machine && name.find("volk_sha256_machine_") == 0;
+            }
+            else if(ELF64_ST_TYPE(syms[j].st_info) == STT_FUNC && !in_other_machine) { // keeps the assembly
+                sizes[name.substr(0, name.find('.'))] += syms[j].st_size; // drop .isra and .constprop
+            }
+        }
+    }
+    return sizes;
+}
+#endif
+
+void run_code_size(const std::string &kernel_name, volk_sha256_func_desc_t desc)
+{
+#if defined(__linux__)
+    static std::map<std::string, size_t> sizes;
+    if(sizes.empty()) {
+        sizes = read_machine_symbol_sizes(std::string("volk_sha256_machine_") + volk_sha256_get_machine() + ".c");
+    }
+    if(sizes.empty()) {
+        std::cout << "RUN_CODE_SIZE: no symbol table in the library" << std::endl;
+        return;
+    }
+
+    std::cout << "RUN_CODE_SIZE: " << kernel_name << std::endl;
+    for(size_t i = 0; i < desc.n_impls; i++) {
+        const std::string impl_name = desc.impl_names[i];
+        const size_t impl_size = sizes[kernel_name + "_" + impl_name];
+        const size_t block_size = sizes["sha256_process_block_" + impl_name] + sizes["sha256_process_blocks_" + impl_name];
+        std::cout << impl_name << " code size: " << impl_size + block_size << " bytes";
+        if(block_size) std::cout << " (" << block_size << " bytes in the block function)";
+        std::cout << std::endl;
+    }
+#else
+    std::cout << "RUN_CODE_SIZE: only supported for ELF libraries on Linux" << std::endl;
+#endif
+}
+
+void read_results(std::vector<volk_sha256_test_results_t> *results, int *prefetch_distance)
 {
     char path[1024];
     volk_sha256_get_config_path(path);
@@ -254,12 +620,15 @@ void read_results(std::vector<volk_sha256_test_results_t> *results)
                 kernel_result.best_arch_a = std::string(single_kernel_result[2]);
                 results->push_back(kernel_result);
             }
+            else if(single_kernel_result.size() == 2 && single_kernel_result[0] == "prefetch_distance") {
+                *prefetch_distance = atoi(single_kernel_result[1].c_str());
+            }
         }
     }
 
 }
 
-void write_results(const std::vector<volk_sha256_test_results_t> *results, bool update_result)
+void write_results(const std::vector<volk_sha256_test_results_t> *results, bool update_result, int prefetch_distance)
 {
     char path[1024];
     volk_sha256_get_config_path(path);
@@ -292,6 +661,7 @@ void write_results(const std::vector<volk_sha256_test_results_t> *results, bool
         config << "\
 #this file is generated by volk_sha256_profile.\n\
 #the function name is followed by the preferred architecture.\n\
+#prefetch_distance is followed by the prefetch distance in bytes.\n\
 ";
     }
 
@@ -301,6 +671,9 @@ void write_results(const std::vector<volk_sha256_test_results_t> *results, bool
             << profile_results->best_arch_a << " "
             << profile_results->best_arch_u << std::endl;
     }
+    if(prefetch_distance >= 0) {
+        config << "prefetch_distance " << prefetch_distance << std::endl;
+    }
     config.close();
 }
 
@@ -1,5 +1,12 @@
 
 
-void read_results(std::vector<volk_sha256_test_results_t> *results);
-void write_results(const std::vector<volk_sha256_test_results_t> *results, bool update_result);
+void read_results(std::vector<volk_sha256_test_results_t> *results, int *prefetch_distance);
+void write_results(const std::vector<volk_sha256_test_results_t> *results, bool update_result, int prefetch_distance);
 void write_json(std::ofstream &json_file, std::vector<volk_sha256_test_results_t> results);
+double time_hash(const char *impl_name, const uint8_t *msg, unsigned int vlen, unsigned int iter);
+void run_alignment_gap(unsigned int vlen, unsigned int iter);
+void run_short_latency(unsigned int iter);
+void run_large_input(int gib);
+void run_prefetch_distance(int mib, int *prefetch_distance);
+void run_pbkdf2(unsigned int iterations);
+void run_code_size(const std::string &kernel_name, volk_sha256_func_desc_t desc);
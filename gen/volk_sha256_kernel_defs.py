@@ -171,6 +171,8 @@ class kernel_class:
             for sub_hdr, body in section:
                 if 'if' not in sub_hdr.lower(): continue
                 if 'LV_HAVE_' not in sub_hdr: continue
+                #sections without an implementation hold arch specific helpers
+                if not re.search('%s_\\w+\\s*\\('%self.name, flatten_section_text(body)): continue
                 self._impls.append(impl_class(
                     kern_name=self.name, header=sub_hdr, body=body,
                 ))
@@ -0,0 +1,167 @@
+#!/usr/bin/env python
+#
+# Copyright 2015 Stefan Wunsch
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+########################################################################
+# Generate the generic implementations of volk_sha256_8u_hash_32u with
+# a rolled round loop, loops unrolled by 2, 4 and 8 and a fully unrolled
+# block. The code replaces the marked region in the kernel header, run
+# this script after changing it and commit the result:
+#   python gen/volk_sha256_unroll_gen.py [--check]
+########################################################################
+
+import os
+import sys
+import optparse
+
+UNROLLS = [(1, 'generic_rolled'), (2, 'generic_unroll2'), (4, 'generic_unroll4'),
+           (8, 'generic_unroll8'), (64, 'generic_unroll64')]
+
+KERNEL_FILE = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))),
+                           'kernels', 'volk_sha256', 'volk_sha256_8u_hash_32u.h')
+BEGIN_MARKER = '/* BEGIN GENERATED BY gen/volk_sha256_unroll_gen.py, DO NOT EDIT */'
+END_MARKER = '/* END GENERATED BY gen/volk_sha256_unroll_gen.py */'
+
+STATE = ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h']
+
+########################################################################
+# Emit the rounds first to last-1 of a block, t is the loop variable
+# holding the first round of the body or None for constant indices
+########################################################################
+def rounds(first, count, t, indent):
+    lines = list()
+    for k in range(count):
+        r = first + k
+        index = str(r) if t is None else ('%s + %d'%(t, k) if k else t)
+        names = STATE[-(k % 8):] + STATE[:-(k % 8)] if k % 8 else STATE
+        if r < 16:
+            w = 'W[%s]'%index
+            lines.append('%s = SWAP_UINT32(%s);'%(w, w))
+        else:
+            ring = lambda d: ('W[%d]'%((r + d) & 15)) if t is None else ('W[(%s + %d) & 15]'%(t, k + d) if k + d else 'W[%s & 15]'%t)
+            w = ring(0)
+            lines.append('%s += SIGMA_1(%s) + %s + SIGMA_0(%s);'%(w, ring(14), ring(9), ring(1)))
+        lines.append('SHA256_ROUND_GENERIC(%s, %s, K[%s]);'%(', '.join(names), w, index))
+    return [indent + line for line in lines]
+
+########################################################################
+# Emit the renaming of a to h after count rounds of a loop body
+########################################################################
+def rotate(count, indent):
+    shift = count % 8
+    if not shift: return list()
+    lines = list()
+    # variable i takes the value of variable i - shift, follow the cycles of this permutation
+    done = set()
+    for start in range(8):
+        if start in done: continue
+        cycle = [start]
+        while (cycle[-1] - shift) % 8 != start: cycle.append((cycle[-1] - shift) % 8)
+        done.update(cycle)
+        lines.append('T1 = %s;'%STATE[cycle[0]])
+        for i in range(len(cycle) - 1): lines.append('%s = %s;'%(STATE[cycle[i]], STATE[cycle[i+1]]))
+        lines.append('%s = T1;'%STATE[cycle[-1]])
+    return [indent + line for line in lines]
+
+########################################################################
+# Emit the block function and the implementation for one unroll factor
+########################################################################
+def block_function(unroll, name):
+    out = list()
+    if unroll == 64: out.append('/* GENERIC: Process N consecutive blocks of 512 bits, all 64 rounds unrolled */')
+    elif unroll == 1: out.append('/* GENERIC: Process N consecutive blocks of 512 bits, one round per loop iteration */')
+    else: out.append('/* GENERIC: Process N consecutive blocks of 512 bits, %d rounds per loop iteration */'%unroll)
+    out.append('static inline void')
+    out.append('sha256_process_blocks_%s(uint32_t* hash, const uint8_t* msg, unsigned int N){'%name)
+    out.append('    uint32_t W[16];')
+    out.append('    uint32_t T1, T2;')
+    out.append('    uint32_t a, b, c, d, e, f, g, h;')
+    out.append('    unsigned int i%s;'%('' if unroll == 64 else ', t'))
+    out.append('')
+    out.append('    for(i=0; i<N; i++){')
+    out.append('        memcpy(W, msg + 64*i, 64);')
+    for i, s in enumerate(STATE): out.append('        %s = hash[%d];'%(s, i))
+    out.append('')
+    if unroll == 64:
+        out.extend(rounds(0, 64, None, '        '))
+    else:
+        out.append('        // Rounds 0 to 15 take the message words')
+        out.append('        for(t=0; t<16; t+=%d){'%unroll)
+        out.extend(rounds(0, unroll, 't', '            '))
+        out.extend(rotate(unroll, '            '))
+        out.append('        }')
+        out.append('')
+        out.append('        // Rounds 16 to 63 calculate W in a ring of 16 words')
+        out.append('        for(t=16; t<64; t+=%d){'%unroll)
+        out.extend(rounds(16, unroll, 't', '            '))
+        out.extend(rotate(unroll, '            '))
+        out.append('        }')
+    out.append('')
+    for i, s in enumerate(STATE): out.append('        hash[%d] += %s;'%(i, s))
+    out.append('    }')
+    out.append('}')
+    return out
+
+def implementation(name):
+    return [
+        '#ifdef LV_HAVE_GENERIC',
+        '',
+        'static inline void',
+        'volk_sha256_8u_hash_32u_%s(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)'%name,
+        '{',
+        '    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_%s);'%name,
+        '}',
+        '',
+        '#endif /* LV_HAVE_GENERIC */',
+    ]
+
+def generate():
+    out = [BEGIN_MARKER, '', '#ifdef LV_HAVE_GENERIC', '']
+    for unroll, name in UNROLLS:
+        out.extend(block_function(unroll, name))
+        out.append('')
+    out.append('#endif /* LV_HAVE_GENERIC */')
+    for unroll, name in UNROLLS:
+        out.append('')
+        out.extend(implementation(name))
+    out.extend(['', END_MARKER])
+    return '\n'.join(out) + '\n'
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--check', action='store_true', default=False,
+                      help='only check that the kernel header is up to date')
+    (opts, args) = parser.parse_args()
+
+    code = open(KERNEL_FILE, 'r').read()
+    begin = code.index(BEGIN_MARKER)
+    end = code.index(END_MARKER) + len(END_MARKER) + 1
+    new_code = code[:begin] + generate() + code[end:]
+
+    if opts.check:
+        if new_code != code:
+            sys.stderr.write('%s is out of date, run %s\n'%(KERNEL_FILE, __file__))
+            return 1
+        return 0
+    if new_code != code: open(KERNEL_FILE, 'w').write(new_code)
+    return 0
+
+if __name__ == '__main__': sys.exit(main())
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_SHA256_HKDF_H
+#define INCLUDED_VOLK_SHA256_HKDF_H
+
+#include <volk_sha256/volk_sha256_common.h>
+#include <inttypes.h>
+
+/*! Length of the pseudorandom key from volk_sha256_hkdf_extract in bytes */
+#define VOLK_SHA256_HKDF_PRK_LEN 32
+/*! Maximum length of the output keying material in bytes, 255 blocks of the hash */
+#define VOLK_SHA256_HKDF_MAX_OKM_LEN (255*32)
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * \brief HKDF-Extract with HMAC-SHA256 (RFC 5869).
+ *
+ * \details
+ * Calculates PRK = HMAC(salt, IKM) with volk_sha256_hmac. A missing salt is the same as a salt
+ * of 32 zero bytes.
+ *
+ * \param prk The 32 byte pseudorandom key.
+ * \param salt The salt, may be NULL if salt_len is zero.
+ * \param salt_len The salt length in bytes.
+ * \param ikm The input keying material.
+ * \param ikm_len The input keying material length in bytes.
+ */
+VOLK_API void volk_sha256_hkdf_extract(uint8_t* prk, const uint8_t* salt, unsigned int salt_len,
+                                       const uint8_t* ikm, unsigned int ikm_len);
+
+/*!
+ * \brief HKDF-Expand with HMAC-SHA256 (RFC 5869).
+ *
+ * \param okm The output keying material.
+ * \param okm_len The output length in bytes, at most VOLK_SHA256_HKDF_MAX_OKM_LEN.
+ * \param prk The 32 byte pseudorandom key.
+ * \param info The context info, may be NULL if info_len is zero.
+ * \param info_len The context info length in bytes.
+ * \return 0 on success, -1 if okm_len is out of range.
+ */
+VOLK_API int volk_sha256_hkdf_expand(uint8_t* okm, unsigned int okm_len, const uint8_t* prk,
+                                     const uint8_t* info, unsigned int info_len);
+
+/*!
+ * \brief HKDF-Expand with HMAC-SHA256 for a batch of sessions.
+ *
+ * \details
+ * Dispatches to volk_sha256_8u_hkdf_expand_8u, which fills the SIMD lanes with different sessions
+ * for the key setup and every block of the expansion. All sessions derive okm_len bytes, the
+ * output of session i starts at okm[okm_len*i].
+ *
+ * \param okm The output keying material of all sessions, okm_len*count bytes.
+ * \param okm_len The output length per session in bytes, at most VOLK_SHA256_HKDF_MAX_OKM_LEN.
+ * \param prks The 32 byte pseudorandom key of each session.
+ * \param infos The context info of each session.
+ * \param info_lens The context info lengths in bytes.
+ * \param count The number of sessions.
+ * \return 0 on success, -1 if okm_len is out of range.
+ */
+VOLK_API int volk_sha256_hkdf_expand_batch(uint8_t* okm, unsigned int okm_len, const uint8_t* const* prks,
+                                           const uint8_t* const* infos, const unsigned int* info_lens,
+                                           unsigned int count);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_SHA256_HKDF_H */
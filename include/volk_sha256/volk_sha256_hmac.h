@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_SHA256_HMAC_H
+#define INCLUDED_VOLK_SHA256_HMAC_H
+
+#include <volk_sha256/volk_sha256_common.h>
+#include <inttypes.h>
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * \brief Precomputed HMAC-SHA256 key.
+ *
+ * \details
+ * Holds the SHA-256 intermediate hash after the key block xor ipad in state[0..7] and after
+ * the key block xor opad in state[8..15]. The key bytes themselves are not kept. A key object
+ * is read-only after volk_sha256_hmac_key_init and can be shared between threads.
+ */
+typedef struct
+{
+  uint32_t state[16];
+} volk_sha256_hmac_key_t;
+
+/*!
+ * \brief Precompute the inner and outer states of an HMAC-SHA256 key.
+ * \param key The key object to initialize.
+ * \param key_bytes The key, keys longer than 64 bytes are replaced by their SHA-256 hash.
+ * \param key_len The key length in bytes.
+ */
+VOLK_API void volk_sha256_hmac_key_init(volk_sha256_hmac_key_t* key, const uint8_t* key_bytes, unsigned int key_len);
+
+/*!
+ * \brief HMAC-SHA256 of one message with a precomputed key.
+ *
+ * \details
+ * Dispatches to volk_sha256_8u_hmac_32u, which processes the message blocks and one final
+ * block of the outer hash with the fastest SHA-256 block function of the machine.
+ *
+ * \param mac The 8 words of the MAC, in the word order of volk_sha256_8u_hash_32u.
+ * \param key The precomputed key.
+ * \param msg The message.
+ * \param msg_len The message length in bytes.
+ */
+VOLK_API void volk_sha256_hmac(uint32_t* mac, const volk_sha256_hmac_key_t* key, const uint8_t* msg, unsigned int msg_len);
+
+/*!
+ * \brief Verify the HMAC-SHA256 tags of a batch of messages.
+ *
+ * \details
+ * Dispatches to volk_sha256_8u_hmac_verify_32u, which fills the SIMD lanes with different
+ * messages for the inner and the outer hash and compares the tags of all lanes at once.
+ * The messages may use the same or different keys. The comparison takes the same time for
+ * matching and wrong tags.
+ *
+ * \param pass Bitmap of (count+31)/32 words, bit i%32 of pass[i/32] is set if tag i matches.
+ * \param keys The precomputed key of each message.
+ * \param msgs The messages.
+ * \param msg_lens The message lengths in bytes.
+ * \param tags The expected tags, 32 bytes in network byte order per message.
+ * \param count The number of messages.
+ */
+VOLK_API void volk_sha256_hmac_verify_batch(uint32_t* pass, const volk_sha256_hmac_key_t* const* keys,
+                                            const uint8_t* const* msgs, const unsigned int* msg_lens,
+                                            const uint8_t* tags, unsigned int count);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_SHA256_HMAC_H */
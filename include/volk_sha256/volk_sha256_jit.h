@@ -0,0 +1,79 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_SHA256_JIT_H
+#define INCLUDED_VOLK_SHA256_JIT_H
+
+#include <volk_sha256/volk_sha256_common.h>
+#include <inttypes.h>
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * \brief Hash function generated for one fixed message length.
+ * \param hash The 8 words of the hash.
+ * \param msg The message of the length the function was compiled for.
+ */
+typedef void (*volk_sha256_jit_func_t)(uint32_t* hash, const uint8_t* msg);
+
+/*!
+ * \brief Generate x86-64 SHA-NI machine code hashing messages of \p msg_len bytes.
+ *
+ * \details
+ * The block loop count and the padding are folded into the code, a padding block
+ * without message bytes is reduced to its precomputed message schedule. The code is
+ * used by the jit implementation of volk_sha256_8u_hash_32u for this length, other
+ * lengths fall back to the SHA-NI assembly kernel. Compiling is serialized by a lock
+ * and may run while other threads hash, a length becomes visible to them once its
+ * code is complete.
+ *
+ * If the environment variable VOLK_SHA256_PERF_MAP is set, every function is
+ * appended to /tmp/perf-<pid>.map so that perf can symbolize the generated code.
+ *
+ * \param msg_len The message length in bytes.
+ * \return 0 on success, -1 if the platform, the CPU or the registry size does not allow it.
+ */
+VOLK_API int volk_sha256_jit_compile(unsigned int msg_len);
+
+/*!
+ * \brief Get the function generated for \p msg_len bytes.
+ *
+ * \details
+ * The lookup is a lock free probe of a hash index, so the jit implementation of
+ * volk_sha256_8u_hash_32u can call it on every hash.
+ *
+ * \return The function or NULL if the length was not compiled.
+ */
+VOLK_API volk_sha256_jit_func_t volk_sha256_jit_get(unsigned int msg_len);
+
+/*!
+ * \brief Release the executable memory of all generated functions.
+ *
+ * \details
+ * No thread may hash with the jit implementation or hold a function from
+ * volk_sha256_jit_get while the memory is released.
+ */
+VOLK_API void volk_sha256_jit_free(void);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_SHA256_JIT_H */
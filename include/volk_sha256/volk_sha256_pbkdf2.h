@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_SHA256_PBKDF2_H
+#define INCLUDED_VOLK_SHA256_PBKDF2_H
+
+#include <volk_sha256/volk_sha256_common.h>
+#include <volk_sha256/volk_sha256_hmac.h>
+#include <inttypes.h>
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * \brief PBKDF2-HMAC-SHA256 of one password (RFC 8018).
+ *
+ * \details
+ * The output blocks of 32 bytes are independent, so a key longer than 32 bytes runs its
+ * blocks in different SIMD lanes of volk_sha256_8u_pbkdf2_8u.
+ *
+ * \param dk The derived key.
+ * \param dk_len The derived key length in bytes.
+ * \param password The password.
+ * \param password_len The password length in bytes.
+ * \param salt The salt, may be NULL if salt_len is zero.
+ * \param salt_len The salt length in bytes.
+ * \param iterations The iteration count, at least 1.
+ * \return 0 on success, -1 if the iteration count is zero.
+ */
+VOLK_API int volk_sha256_pbkdf2(uint8_t* dk, unsigned int dk_len, const uint8_t* password, unsigned int password_len,
+                                const uint8_t* salt, unsigned int salt_len, unsigned int iterations);
+
+/*!
+ * \brief PBKDF2-HMAC-SHA256 of a batch of passwords with precomputed keys.
+ *
+ * \details
+ * Dispatches to volk_sha256_8u_pbkdf2_8u, which fills the SIMD lanes with the output blocks of
+ * all passwords. Every iteration hashes a 32 byte message from the precomputed ipad and opad
+ * states of the key, so it costs two compressions. All passwords use the same iteration count
+ * and derive dk_len bytes, the key of password i starts at dk[dk_len*i].
+ *
+ * \param dk The derived keys of all passwords, dk_len*count bytes.
+ * \param dk_len The derived key length per password in bytes.
+ * \param passwords The password of each derivation as a precomputed HMAC key.
+ * \param salts The salt of each derivation.
+ * \param salt_lens The salt lengths in bytes.
+ * \param iterations The iteration count, at least 1.
+ * \param count The number of passwords.
+ * \return 0 on success, -1 if the iteration count is zero.
+ */
+VOLK_API int volk_sha256_pbkdf2_batch(uint8_t* dk, unsigned int dk_len, const volk_sha256_hmac_key_t* const* passwords,
+                                      const uint8_t* const* salts, const unsigned int* salt_lens,
+                                      unsigned int iterations, unsigned int count);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_SHA256_PBKDF2_H */
@@ -0,0 +1,54 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_VOLK_SHA256_PREFETCH_H
+#define INCLUDED_VOLK_SHA256_PREFETCH_H
+
+#include <volk_sha256/volk_sha256_common.h>
+
+__VOLK_DECL_BEGIN
+
+/*! Prefetch distance in bytes used until the config or the caller sets another one */
+#define VOLK_SHA256_DEFAULT_PREFETCH_DISTANCE 4096
+
+/*!
+ * \brief Get the distance in bytes the large input implementations prefetch ahead of the hashed block.
+ *
+ * \details
+ * The _prefetch implementations of volk_sha256_8u_hash_32u and volk_sha256_8u_hash64_32u
+ * request the cache lines this far ahead with the non-temporal hint. The distance comes from
+ * the line "prefetch_distance <bytes>" of the volk_sha256_config, read once together with the
+ * preferred implementations, which volk_sha256_profile writes with the --prefetch-distance
+ * option. Distances are rounded up to whole cache lines of 64 bytes, only a distance of 0
+ * disables the software prefetches.
+ */
+VOLK_API unsigned int volk_sha256_get_prefetch_distance(void);
+
+/*!
+ * \brief Set the prefetch distance, overrides the value of the config.
+ * \param distance The distance in bytes, rounded up to whole cache lines of 64 bytes.
+ */
+VOLK_API void volk_sha256_set_prefetch_distance(unsigned int distance);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_SHA256_PREFETCH_H */
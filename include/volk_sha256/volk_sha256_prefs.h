@@ -13,6 +13,13 @@ typedef struct volk_sha256_arch_pref
     char impl_u[128]; //best unaligned impl
 } volk_sha256_arch_pref_t;
 
+typedef struct volk_sha256_config
+{
+    volk_sha256_arch_pref_t *arch_prefs; //preferred impls of the profiled kernels
+    size_t n_arch_prefs;                 //number of entries in arch_prefs
+    unsigned int prefetch_distance;      //from the prefetch_distance line, else the default
+} volk_sha256_config_t;
+
 ////////////////////////////////////////////////////////////////////////
 // get path to volk_sha256_config profiling info;
 // returns \0 in the argument on failure.
@@ -24,6 +31,12 @@ VOLK_API void volk_sha256_get_config_path(char *);
 ////////////////////////////////////////////////////////////////////////
 VOLK_API size_t volk_sha256_load_preferences(volk_sha256_arch_pref_t **);
 
+////////////////////////////////////////////////////////////////////////
+// get the volk_sha256_config, read once on the first call and shared
+// by the dispatcher and the library settings
+////////////////////////////////////////////////////////////////////////
+VOLK_API const volk_sha256_config_t *volk_sha256_get_config(void);
+
 __VOLK_DECL_END
 
 #endif //INCLUDED_VOLK_SHA256_PREFS_H
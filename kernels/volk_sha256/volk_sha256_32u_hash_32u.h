@@ -0,0 +1,287 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+#include <volk_sha256/volk_sha256_8u_x8_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes num_points/8 digests of 32 bytes (hash-of-hash), digest i is taken from digest[8*i] to digest[8*i+7]
+ * in the word order of the hash kernels and its hash is written to hash[8*i] to hash[8*i+7].
+ * The message always fits one block, so the padding words are constants and all length handling is skipped.
+ * This header also holds the helpers of the other fixed length kernels, which run the rounds on message
+ * words and on a precomputed schedule W + K.
+ */
+
+#ifndef INCLUDED_volk_sha256_32u_hash_32u_a_H
+#define INCLUDED_volk_sha256_32u_hash_32u_a_H
+
+/* W + K of the padding block of 64 byte messages, the block only holds 0x80 and the length of 512 bits */
+static const uint32_t SHA256_PAD64_WK[64] = {
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76};
+
+/* GENERIC: Run the 64 rounds on a precomputed schedule W + K and update the hash */
+static inline void
+sha256_process_wk_generic(uint32_t* hash, const uint32_t* WK){
+    uint32_t a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int t;
+
+    a = hash[0];
+    b = hash[1];
+    c = hash[2];
+    d = hash[3];
+    e = hash[4];
+    f = hash[5];
+    g = hash[6];
+    h = hash[7];
+
+    for(t=0; t<64; t+=8){
+        SHA256_ROUNDS4_WK(a, b, c, d, e, f, g, h, WK[t], WK[t+1], WK[t+2], WK[t+3]);
+        SHA256_ROUNDS4_WK(e, f, g, h, a, b, c, d, WK[t+4], WK[t+5], WK[t+6], WK[t+7]);
+    }
+
+    hash[0] += a;
+    hash[1] += b;
+    hash[2] += c;
+    hash[3] += d;
+    hash[4] += e;
+    hash[5] += f;
+    hash[6] += g;
+    hash[7] += h;
+}
+
+/* GENERIC: Process one block given as 16 message words instead of bytes */
+static inline void
+sha256_process_words_generic(uint32_t* hash, const uint32_t* M){
+    uint32_t W[64], WK[64];
+    unsigned int t;
+
+    for(t=0; t<16; t++) W[t] = M[t];
+    for(t=16; t<64; t++) W[t] = SIGMA_1(W[t-2]) + W[t-7] + SIGMA_0(W[t-15]) + W[t-16];
+    for(t=0; t<64; t++) WK[t] = W[t] + K[t];
+
+    sha256_process_wk_generic(hash, WK);
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_32u_hash_32u_generic(uint32_t* hash, const uint32_t* digest, unsigned int num_points)
+{
+    uint32_t M[16] = {0}; // digest followed by the constant padding words
+    unsigned int i;
+
+    M[8] = 0x80000000;
+    M[15] = 256; // length in bits
+    for(i=0; i<num_points/8; i++){
+        memcpy(M, digest + 8*i, 32);
+        memcpy(hash + 8*i, H0, sizeof(H0));
+        sha256_process_words_generic(hash + 8*i, M);
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Single round on eight messages with a precomputed W + K, which is the same in all lanes */
+#define SHA256_ROUND_WK_AVX2(a, b, c, d, e, f, g, h, WK)                                        \
+T1 = _mm256_add_epi32(_mm256_add_epi32(h, EPSILON_1_AVX2(e)), _mm256_add_epi32(CH_AVX2(e, f, g), \
+    _mm256_set1_epi32(WK)));                                                                    \
+d = _mm256_add_epi32(d, T1);                                                                    \
+T2 = _mm256_add_epi32(EPSILON_0_AVX2(a), MAJ_AVX2(a, b, c));                                    \
+h = _mm256_add_epi32(T1, T2)
+
+/* AVX2: Run the 64 rounds on eight messages with a precomputed schedule W + K, s holds a to h */
+static inline void
+sha256_rounds_wk_x8_avx2(__m256i* s, const uint32_t* WK){
+    __m256i a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int t;
+
+    a = s[0];
+    b = s[1];
+    c = s[2];
+    d = s[3];
+    e = s[4];
+    f = s[5];
+    g = s[6];
+    h = s[7];
+
+    for(t=0; t<64; t+=8){
+        SHA256_ROUND_WK_AVX2(a, b, c, d, e, f, g, h, WK[t]);
+        SHA256_ROUND_WK_AVX2(h, a, b, c, d, e, f, g, WK[t+1]);
+        SHA256_ROUND_WK_AVX2(g, h, a, b, c, d, e, f, WK[t+2]);
+        SHA256_ROUND_WK_AVX2(f, g, h, a, b, c, d, e, WK[t+3]);
+        SHA256_ROUND_WK_AVX2(e, f, g, h, a, b, c, d, WK[t+4]);
+        SHA256_ROUND_WK_AVX2(d, e, f, g, h, a, b, c, WK[t+5]);
+        SHA256_ROUND_WK_AVX2(c, d, e, f, g, h, a, b, WK[t+6]);
+        SHA256_ROUND_WK_AVX2(b, c, d, e, f, g, h, a, WK[t+7]);
+    }
+
+    s[0] = a;
+    s[1] = b;
+    s[2] = c;
+    s[3] = d;
+    s[4] = e;
+    s[5] = f;
+    s[6] = g;
+    s[7] = h;
+}
+
+/* AVX2: Load eight digests as rows and transpose to get the words W[0] to W[7] of all messages */
+static inline void
+sha256_load_digests_x8_avx2(__m256i* W, const uint32_t* digest){
+    unsigned int i;
+    for(i=0; i<8; i++) W[i] = _mm256_loadu_si256((const __m256i*) (digest + 8*i));
+    sha256_transpose8x8_avx2(W);
+}
+
+/* AVX2: Run the rounds on the words W and add the result to the state */
+static inline void
+sha256_update_words_x8_avx2(__m256i* state, __m256i* W){
+    __m256i s[8];
+    unsigned int i;
+    for(i=0; i<8; i++) s[i] = state[i];
+    sha256_rounds_x8_avx2(s, W);
+    for(i=0; i<8; i++) state[i] = _mm256_add_epi32(state[i], s[i]);
+}
+
+/* AVX2: Transpose the state of eight messages back to one hash per message */
+static inline void
+sha256_store_state_x8_avx2(uint32_t* hash, __m256i* state){
+    unsigned int i;
+    sha256_transpose8x8_avx2(state);
+    for(i=0; i<8; i++) _mm256_storeu_si256((__m256i*) (hash + 8*i), state[i]);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_32u_hash_32u_avx2(uint32_t* hash, const uint32_t* digest, unsigned int num_points)
+{
+    __m256i state[8], W[16];
+    unsigned int i, t;
+
+    for(i=0; i+8<=num_points/8; i+=8){
+        sha256_load_digests_x8_avx2(W, digest + 8*i);
+        W[8] = _mm256_set1_epi32(0x80000000);
+        for(t=9; t<15; t++) W[t] = _mm256_setzero_si256();
+        W[15] = _mm256_set1_epi32(256); // length in bits
+
+        for(t=0; t<8; t++) state[t] = _mm256_set1_epi32(H0[t]);
+        sha256_update_words_x8_avx2(state, W);
+        sha256_store_state_x8_avx2(hash + 8*i, state);
+    }
+
+    // Hash the remaining digests one by one
+    volk_sha256_32u_hash_32u_generic(hash + 8*i, digest + 8*i, num_points - 8*i);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+#include <immintrin.h>
+
+/* SHA-NI: Process one block given as message words in MSG0 to MSG3 */
+static inline void
+sha256_process_words_shani(__m128i* state0, __m128i* state1, __m128i MSG0, __m128i MSG1, __m128i MSG2, __m128i MSG3){
+    __m128i STATE0 = *state0, STATE1 = *state1, TMP;
+
+    SHA256_SHANI_ROUNDS4(MSG0, 0);
+    SHA256_SHANI_ROUNDS4(MSG1, 4);
+    MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
+    SHA256_SHANI_ROUNDS4(MSG2, 8);
+    MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
+    SHA256_SHANI_ROUNDS4_MSG(MSG3, MSG0, MSG2, 12);
+    SHA256_SHANI_ROUNDS4_MSG(MSG0, MSG1, MSG3, 16);
+    SHA256_SHANI_ROUNDS4_MSG(MSG1, MSG2, MSG0, 20);
+    SHA256_SHANI_ROUNDS4_MSG(MSG2, MSG3, MSG1, 24);
+    SHA256_SHANI_ROUNDS4_MSG(MSG3, MSG0, MSG2, 28);
+    SHA256_SHANI_ROUNDS4_MSG(MSG0, MSG1, MSG3, 32);
+    SHA256_SHANI_ROUNDS4_MSG(MSG1, MSG2, MSG0, 36);
+    SHA256_SHANI_ROUNDS4_MSG(MSG2, MSG3, MSG1, 40);
+    SHA256_SHANI_ROUNDS4_MSG(MSG3, MSG0, MSG2, 44);
+    SHA256_SHANI_ROUNDS4_MSG(MSG0, MSG1, MSG3, 48);
+    SHA256_SHANI_ROUNDS4_MSG(MSG1, MSG2, MSG0, 52);
+    SHA256_SHANI_ROUNDS4_MSG(MSG2, MSG3, MSG1, 56);
+    SHA256_SHANI_ROUNDS4(MSG3, 60);
+
+    *state0 = _mm_add_epi32(*state0, STATE0);
+    *state1 = _mm_add_epi32(*state1, STATE1);
+}
+
+/* SHA-NI: Process one block with a precomputed schedule W + K */
+static inline void
+sha256_process_wk_shani(__m128i* state0, __m128i* state1, const uint32_t* WK){
+    __m128i STATE0 = *state0, STATE1 = *state1, TMP;
+    unsigned int t;
+
+    for(t=0; t<64; t+=4){
+        TMP = _mm_loadu_si128((const __m128i*) &WK[t]);
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, TMP);
+        TMP = _mm_shuffle_epi32(TMP, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, TMP);
+    }
+
+    *state0 = _mm_add_epi32(*state0, STATE0);
+    *state1 = _mm_add_epi32(*state1, STATE1);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_32u_hash_32u_shani(uint32_t* hash, const uint32_t* digest, unsigned int num_points)
+{
+    const __m128i PAD0 = _mm_set_epi32(0, 0, 0, 0x80000000);
+    const __m128i PAD1 = _mm_set_epi32(256, 0, 0, 0); // length in bits
+    __m128i STATE0, STATE1;
+    unsigned int i;
+
+    sha256_shani_enter();
+
+    for(i=0; i<num_points/8; i++){
+        sha256_load_state_shani(H0, &STATE0, &STATE1);
+        sha256_process_words_shani(&STATE0, &STATE1, _mm_loadu_si128((const __m128i*) (digest + 8*i)),
+                                   _mm_loadu_si128((const __m128i*) (digest + 8*i + 4)), PAD0, PAD1);
+        sha256_store_state_shani(hash + 8*i, STATE0, STATE1);
+    }
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_32u_hash_32u_a_H */
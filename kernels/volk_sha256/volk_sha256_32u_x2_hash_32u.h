@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_32u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes num_points/8 pairs of digests of 32 bytes each (Merkle tree nodes), pair i is the concatenation of
+ * left[8*i] to left[8*i+7] and right[8*i] to right[8*i+7] in the word order of the hash kernels.
+ * The hash of pair i is written to hash[8*i] to hash[8*i+7].
+ * The 64 byte message fills the first block, the second block only holds the padding, so its whole schedule
+ * W + K is precomputed in SHA256_PAD64_WK.
+ */
+
+#ifndef INCLUDED_volk_sha256_32u_x2_hash_32u_a_H
+#define INCLUDED_volk_sha256_32u_x2_hash_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_32u_x2_hash_32u_generic(uint32_t* hash, const uint32_t* left, const uint32_t* right, unsigned int num_points)
+{
+    uint32_t M[16];
+    unsigned int i;
+
+    for(i=0; i<num_points/8; i++){
+        memcpy(M, left + 8*i, 32);
+        memcpy(M + 8, right + 8*i, 32);
+        memcpy(hash + 8*i, H0, sizeof(H0));
+        sha256_process_words_generic(hash + 8*i, M);
+        sha256_process_wk_generic(hash + 8*i, SHA256_PAD64_WK);
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_32u_x2_hash_32u_avx2(uint32_t* hash, const uint32_t* left, const uint32_t* right, unsigned int num_points)
+{
+    __m256i state[8], s[8], W[16];
+    unsigned int i, t;
+
+    for(i=0; i+8<=num_points/8; i+=8){
+        sha256_load_digests_x8_avx2(W, left + 8*i);
+        sha256_load_digests_x8_avx2(W + 8, right + 8*i);
+
+        for(t=0; t<8; t++) state[t] = _mm256_set1_epi32(H0[t]);
+        sha256_update_words_x8_avx2(state, W);
+
+        // Padding block with the precomputed schedule
+        for(t=0; t<8; t++) s[t] = state[t];
+        sha256_rounds_wk_x8_avx2(s, SHA256_PAD64_WK);
+        for(t=0; t<8; t++) state[t] = _mm256_add_epi32(state[t], s[t]);
+
+        sha256_store_state_x8_avx2(hash + 8*i, state);
+    }
+
+    // Hash the remaining pairs one by one
+    volk_sha256_32u_x2_hash_32u_generic(hash + 8*i, left + 8*i, right + 8*i, num_points - 8*i);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_32u_x2_hash_32u_shani(uint32_t* hash, const uint32_t* left, const uint32_t* right, unsigned int num_points)
+{
+    __m128i STATE0, STATE1;
+    unsigned int i;
+
+    sha256_shani_enter();
+
+    for(i=0; i<num_points/8; i++){
+        sha256_load_state_shani(H0, &STATE0, &STATE1);
+        sha256_process_words_shani(&STATE0, &STATE1,
+                                   _mm_loadu_si128((const __m128i*) (left + 8*i)), _mm_loadu_si128((const __m128i*) (left + 8*i + 4)),
+                                   _mm_loadu_si128((const __m128i*) (right + 8*i)), _mm_loadu_si128((const __m128i*) (right + 8*i + 4)));
+        sha256_process_wk_shani(&STATE0, &STATE1, SHA256_PAD64_WK);
+        sha256_store_state_shani(hash + 8*i, STATE0, STATE1);
+    }
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_32u_x2_hash_32u_a_H */
@@ -0,0 +1,224 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Copies msg_len bytes from src to dst and writes the hash of the message to hash. The message is
+ * copied and hashed in chunks of SHA256_COPY_HASH_CHUNK blocks, so the hash reads each chunk back
+ * from the L1 cache and the source passes the memory bus once. The _nt implementations write dst
+ * with non-temporal stores, which do not pull the destination into the cache.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_copy_hash_32u_H
+#define INCLUDED_volk_sha256_8u_copy_hash_32u_H
+
+/* Number of blocks of 512 bits copied before they are hashed, 4 KiB stay in the L1 cache */
+#define SHA256_COPY_HASH_CHUNK 64
+
+/* Function copying N consecutive blocks of 512 bits */
+typedef void (*sha256_copy_func_t)(uint8_t* dst, const uint8_t* src, unsigned int N);
+
+/* Copy and hash a whole message with a copy function and a function processing blocks of 512 bits */
+static inline void
+sha256_copy_hash_blocks(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len,
+                        sha256_copy_func_t copy_blocks, sha256_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t tail[128]; // padding blocks
+    const unsigned int N = msg_len / 64; // number of full 512 bit blocks
+    const unsigned int R = msg_len % 64; // rest bytes
+    unsigned int i, n;
+
+    memcpy(hash, H0, sizeof(H0));
+    for(i=0; i<N; i+=n){
+        n = (N - i < SHA256_COPY_HASH_CHUNK) ? N - i : SHA256_COPY_HASH_CHUNK;
+        copy_blocks(dst + 64*i, src + 64*i, n);
+        process_blocks(hash, src + 64*i, n);
+    }
+    memcpy(dst + 64*N, src + 64*N, R);
+    process_blocks(hash, tail, sha256_pad_tail(tail, src + 64*N, R, (uint64_t) msg_len * 8));
+}
+
+/* GENERIC: Copy N blocks of 512 bits */
+static inline void
+sha256_copy_blocks_generic(uint8_t* dst, const uint8_t* src, unsigned int N){
+    memcpy(dst, src, 64*N);
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_copy_hash_32u_generic(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_generic, sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+/* SSE2: Copy with aligned loads and stores */
+static inline void
+sha256_copy_blocks_a_sse2(uint8_t* dst, const uint8_t* src, unsigned int N){
+    unsigned int i;
+    for(i=0; i<4*N; i++) _mm_store_si128((__m128i*) dst + i, _mm_load_si128((const __m128i*) src + i));
+}
+
+/* SSE2: Copy with unaligned loads and stores */
+static inline void
+sha256_copy_blocks_u_sse2(uint8_t* dst, const uint8_t* src, unsigned int N){
+    unsigned int i;
+    for(i=0; i<4*N; i++) _mm_storeu_si128((__m128i*) dst + i, _mm_loadu_si128((const __m128i*) src + i));
+}
+
+/* SSE2: Copy with aligned loads and non-temporal stores */
+static inline void
+sha256_copy_blocks_nt_sse2(uint8_t* dst, const uint8_t* src, unsigned int N){
+    unsigned int i;
+    for(i=0; i<4*N; i++) _mm_stream_si128((__m128i*) dst + i, _mm_load_si128((const __m128i*) src + i));
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+/* AVX: Copy with aligned loads and stores */
+static inline void
+sha256_copy_blocks_a_avx(uint8_t* dst, const uint8_t* src, unsigned int N){
+    unsigned int i;
+    for(i=0; i<2*N; i++) _mm256_store_si256((__m256i*) dst + i, _mm256_load_si256((const __m256i*) src + i));
+}
+
+/* AVX: Copy with unaligned loads and stores */
+static inline void
+sha256_copy_blocks_u_avx(uint8_t* dst, const uint8_t* src, unsigned int N){
+    unsigned int i;
+    for(i=0; i<2*N; i++) _mm256_storeu_si256((__m256i*) dst + i, _mm256_loadu_si256((const __m256i*) src + i));
+}
+
+/* AVX: Copy with aligned loads and non-temporal stores */
+static inline void
+sha256_copy_blocks_nt_avx(uint8_t* dst, const uint8_t* src, unsigned int N){
+    unsigned int i;
+    for(i=0; i<2*N; i++) _mm256_stream_si256((__m256i*) dst + i, _mm256_load_si256((const __m256i*) src + i));
+}
+
+#endif /* LV_HAVE_AVX */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_copy_hash_32u_a_sse4_1(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_a_sse2, sha256_process_blocks_a_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_copy_hash_32u_u_sse4_1(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_u_sse2, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_copy_hash_32u_a_sse4_1_nt(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_nt_sse2, sha256_process_blocks_a_sse4_1);
+    _mm_sfence(); // order the non-temporal stores before later stores
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_copy_hash_32u_a_avx2(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_a_avx, sha256_process_blocks_a_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_copy_hash_32u_u_avx2(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_u_avx, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_copy_hash_32u_a_avx2_nt(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_nt_avx, sha256_process_blocks_a_avx2_bmi2);
+    _mm_sfence(); // order the non-temporal stores before later stores
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_copy_hash_32u_a_shani(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_a_sse2, sha256_process_blocks_a_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_copy_hash_32u_u_shani(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_u_sse2, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_copy_hash_32u_a_shani_nt(uint32_t* hash, uint8_t* dst, const uint8_t* src, unsigned int msg_len)
+{
+    sha256_copy_hash_blocks(hash, dst, src, msg_len, sha256_copy_blocks_nt_sse2, sha256_process_blocks_a_shani);
+    _mm_sfence(); // order the non-temporal stores before later stores
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_copy_hash_32u_H */
@@ -0,0 +1,154 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * SHA-224 of one message. SHA-224 is the SHA-256 compression run from another initial hash, the digest is the
+ * first seven words of the final state. The implementations hand the block functions of volk_sha256_8u_hash_32u
+ * to sha224_hash_blocks, so every change of a block function applies to both digests.
+ * The hash is written to hash[0] to hash[6].
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash224_32u_a_H
+#define INCLUDED_volk_sha256_8u_hash224_32u_a_H
+
+/* Hash a whole message with SHA-224 with a function processing blocks of 512 bits */
+static inline void
+sha224_hash_blocks(uint32_t* hash, const uint8_t* msg, uint64_t msg_len, sha256_blocks_func_t process_blocks){
+    uint32_t state[8];
+    sha256_hash_blocks_iv(state, H0_224, msg, msg_len, process_blocks);
+    memcpy(hash, state, 7*sizeof(uint32_t));
+}
+
+/* Truncate the eight word states of count messages to the seven word SHA-224 hashes */
+static inline void
+sha224_truncate_hashes(uint32_t* hash, const uint32_t* state, unsigned int count){
+    unsigned int i;
+    for(i=0; i<count; i++) memcpy(hash + 7*i, state + 8*i, 7*sizeof(uint32_t));
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash224_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hash224_32u_a_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hash224_32u_u_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash224_32u_a_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash224_32u_u_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash224_32u_a_avx2(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash224_32u_u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash224_32u_a_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash224_32u_u_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash224_32u_shani_asm(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_shani_enter();
+    sha224_hash_blocks(hash, msg, msg_len, sha256_process_blocks_shani_asm);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash224_32u_a_H */
@@ -0,0 +1,214 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+
+/*
+ * NOTE:
+ * SHA-512 of one message, the hash is written as eight 64 bit words to hash[0] to hash[7].
+ * SHA-512 runs 80 rounds on blocks of 1024 bits with 64 bit words, the padding ends with a 128 bit length.
+ * This header holds the SHA-512 constants and block functions for the whole family: volk_sha256_8u_hash384_64u,
+ * volk_sha256_8u_hash512t256_64u and the multi-buffer kernels volk_sha256_8u_x4_hash512_64u and
+ * volk_sha256_8u_x8_hash512_64u only differ in the initial hash, the truncation and the number of lanes.
+ * Reference: FIPS 180-4, check against sha512sum, sha384sum and openssl dgst -sha512-256.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash512_64u_a_H
+#define INCLUDED_volk_sha256_8u_hash512_64u_a_H
+
+/* Define operations needed for sha512 main loop */
+#define ROTR64(x, n)        ( ((x) >> (n)) | ((x) << (64 - (n))) )
+#define EPSILON512_0(x)     ( ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39) )
+#define EPSILON512_1(x)     ( ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41) )
+#define SIGMA512_0(x)       ( ROTR64(x, 1)  ^ ROTR64(x, 8)  ^ ((x) >> 7) )
+#define SIGMA512_1(x)       ( ROTR64(x, 19) ^ ROTR64(x, 61) ^ ((x) >> 6) )
+#define CH64(x, y, z)       ( ((x) & (y)) ^ ((~(x)) & (z)) )
+#define MAJ64(x, y, z)      ( ((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)) )
+#define SWAP_UINT64(x)      ( ((uint64_t) SWAP_UINT32_512((uint32_t) (x)) << 32) | SWAP_UINT32_512((uint32_t) ((x) >> 32)) )
+#define SWAP_UINT32_512(x)  ( ((x) >> 24) | (((x) & 0x00FF0000) >> 8) | (((x) & 0x0000FF00) << 8) | ((x) << 24) )
+
+static const uint64_t K512[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+/* Initial hash value H(0) of SHA-512 */
+static const uint64_t H0_512[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+/* Initial hash value H(0) of SHA-384, the hash is the first six words */
+static const uint64_t H0_384[8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL};
+
+/* Initial hash value H(0) of SHA-512/256, the hash is the first four words */
+static const uint64_t H0_512_256[8] = {
+    0x22312194fc2bf72cULL, 0x9f555fa3c84c64c2ULL, 0x2393b86b6f53b151ULL, 0x963877195940eabdULL,
+    0x96283ee2a88effe3ULL, 0xbe5e1e2553863992ULL, 0x2b0199fc2c85b8aaULL, 0x0eb72ddc81c52ca2ULL};
+
+/* Function processing N consecutive blocks of 1024 bits */
+typedef void (*sha512_blocks_func_t)(uint64_t* hash, const uint8_t* msg, unsigned int N);
+
+/* Pad the rest bytes (R < 128) of a message into one or two blocks of 1024 bits, returns the number of blocks */
+static inline unsigned int
+sha512_pad_tail(uint8_t* block, const uint8_t* rest, unsigned int R, uint64_t msg_len_bits){
+    unsigned int i;
+    const unsigned int n = (R < 112) ? 1 : 2; // the length needs the last 16 bytes of a block
+
+    memcpy(block, rest, R); // copy rest of message
+    block[R] = 0x80; // add 0x80 (1 followed by zeros) to message
+    memset(block + R + 1, 0x00, 128*n - 8 - (R + 1)); // set rest up to last 8 byte to zero, covers the upper length
+
+    // write last 8 bytes with message length in bits in big endian format
+    for (i = 0; i < 8; i++) block[128*n - 1 - i] = msg_len_bits >> (i*8);
+
+    return n;
+}
+
+/* Hash a whole message starting from the initial hash iv with a function processing blocks of 1024 bits */
+static inline void
+sha512_hash_blocks_iv(uint64_t* hash, const uint64_t* iv, const uint8_t* msg, uint64_t msg_len,
+                      sha512_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t tail[256]; // padding blocks
+    uint64_t N = msg_len / 128; // number of full 1024 bit blocks
+    const uint8_t* rest = msg + 128*N;
+
+    memcpy(hash, iv, 8*sizeof(uint64_t));
+    for(; N > (1u << 24); N -= (1u << 24)){
+        process_blocks(hash, msg, 1u << 24);
+        msg += 128*(uint64_t) (1u << 24);
+    }
+    process_blocks(hash, msg, (unsigned int) N);
+    process_blocks(hash, tail, sha512_pad_tail(tail, rest, msg_len % 128, msg_len * 8));
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/* GENERIC: Single round in the sha512 main loop */
+#define SHA512_ROUND_GENERIC(a, b, c, d, e, f, g, h, W, K) \
+T1 = h + EPSILON512_1(e) + CH64(e, f, g) + W + K;          \
+d += T1;                                                   \
+T2 = EPSILON512_0(a) + MAJ64(a, b, c);                     \
+h = T1 + T2
+
+/* GENERIC: Calculate W[t] in place of W[t-16] */
+#define SHA512_SCHEDULE_GENERIC(W, t) \
+W[(t)&15] += SIGMA512_1(W[((t)-2)&15]) + W[((t)-7)&15] + SIGMA512_0(W[((t)-15)&15])
+
+/* GENERIC: Process N consecutive blocks of 1024 bits */
+static inline void
+sha512_process_blocks_generic(uint64_t* hash, const uint8_t* msg, unsigned int N){
+    uint64_t W[16];
+    uint64_t T1, T2;
+    uint64_t a, b, c, d, e, f, g, h;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 128*i, 128);
+        for(t=0; t<16; t++) W[t] = SWAP_UINT64(W[t]);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // First 16 rounds take the message directly
+        for(t=0; t<16; t+=8){
+            SHA512_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t], K512[t]);
+            SHA512_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[t+1], K512[t+1]);
+            SHA512_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[t+2], K512[t+2]);
+            SHA512_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[t+3], K512[t+3]);
+            SHA512_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[t+4], K512[t+4]);
+            SHA512_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[t+5], K512[t+5]);
+            SHA512_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[t+6], K512[t+6]);
+            SHA512_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[t+7], K512[t+7]);
+        }
+
+        // Remaining rounds calculate W in a ring of 16 words
+        for(t=16; t<80; t+=8){
+            SHA512_SCHEDULE_GENERIC(W, t);
+            SHA512_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t&15], K512[t]);
+            SHA512_SCHEDULE_GENERIC(W, t+1);
+            SHA512_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[(t+1)&15], K512[t+1]);
+            SHA512_SCHEDULE_GENERIC(W, t+2);
+            SHA512_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[(t+2)&15], K512[t+2]);
+            SHA512_SCHEDULE_GENERIC(W, t+3);
+            SHA512_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[(t+3)&15], K512[t+3]);
+            SHA512_SCHEDULE_GENERIC(W, t+4);
+            SHA512_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[(t+4)&15], K512[t+4]);
+            SHA512_SCHEDULE_GENERIC(W, t+5);
+            SHA512_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[(t+5)&15], K512[t+5]);
+            SHA512_SCHEDULE_GENERIC(W, t+6);
+            SHA512_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[(t+6)&15], K512[t+6]);
+            SHA512_SCHEDULE_GENERIC(W, t+7);
+            SHA512_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[(t+7)&15], K512[t+7]);
+        }
+
+        // Get intermediate hash
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash512_64u_generic(uint64_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha512_hash_blocks_iv(hash, H0_512, msg, msg_len, sha512_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_sha256_8u_hash512_64u_a_H */
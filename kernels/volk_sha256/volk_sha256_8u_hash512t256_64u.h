@@ -0,0 +1,48 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256_8u_hash512_64u.h>
+
+/*
+ * NOTE:
+ * SHA-512/256 of one message: the SHA-512 block functions of volk_sha256_8u_hash512_64u from the SHA-512/256 initial hash,
+ * the hash is the first four words of the final state and is written to hash[0] to hash[3].
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash512t256_64u_a_H
+#define INCLUDED_volk_sha256_8u_hash512t256_64u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash512t256_64u_generic(uint64_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    uint64_t state[8];
+    sha512_hash_blocks_iv(state, H0_512_256, msg, msg_len, sha512_process_blocks_generic);
+    memcpy(hash, state, 4*sizeof(uint64_t));
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_sha256_8u_hash512t256_64u_a_H */
@@ -0,0 +1,162 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Same as volk_sha256_8u_hash_32u with a 64 bit message length for inputs of 4 GiB and more.
+ * The length block is encoded from the full 64 bit length, the blocks are handed to the block functions
+ * in chunks so the block counts fit their unsigned int arguments.
+ * The _prefetch implementations only help when the message streams from memory faster than the hardware
+ * prefetcher keeps up, e.g. several concurrent streams, so they come after the plain ones and the
+ * dispatcher only picks them from the config.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash64_32u_a_H
+#define INCLUDED_volk_sha256_8u_hash64_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash64_32u_generic(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hash64_32u_a_ssse3(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hash64_32u_u_ssse3(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_32u_a_sse4_1(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_32u_u_sse4_1(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash64_32u_a_avx2(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash64_32u_u_avx2(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_32u_a_shani(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_32u_u_shani(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_32u_u_sse4_1_prefetch(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks_prefetch(hash, msg, msg_len, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash64_32u_u_avx2_prefetch(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks_prefetch(hash, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_32u_u_shani_prefetch(uint32_t* hash, const uint8_t* msg, uint64_t msg_len)
+{
+    sha256_hash_blocks_prefetch(hash, msg, msg_len, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash64_32u_a_H */
@@ -0,0 +1,156 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <volk_sha256/volk_sha256_8u_hash64_32u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_hash64_32u for the QA and the profiler, which call kernels with an unsigned int
+ * num_points. The length is widened before the call, the multi-GB inputs are covered by the --large-input
+ * option of the profiler.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash64_puppet_32u_H
+#define INCLUDED_volk_sha256_8u_hash64_puppet_32u_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_generic(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_a_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_a_ssse3(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_ssse3(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_a_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_a_sse4_1(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_sse4_1(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_a_avx2(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_a_avx2(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_avx2(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_a_shani(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_a_shani(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_shani(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_shani(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_sse4_1_prefetch(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_sse4_1_prefetch(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_avx2_prefetch(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_avx2_prefetch(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash64_puppet_32u_u_shani_prefetch(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    volk_sha256_8u_hash64_32u_u_shani_prefetch(hash, msg, (uint64_t) num_points);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash64_puppet_32u_H */
@@ -0,0 +1,126 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_32u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes num_points/80 consecutive messages of 80 bytes (block headers), message i starts at msg[80*i] and
+ * its hash is written to hash[8*i] to hash[8*i+7].
+ * The first block is a full message block, the second block holds the last 16 bytes followed by constant
+ * padding words, so all length handling is skipped.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash80_32u_a_H
+#define INCLUDED_volk_sha256_8u_hash80_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash80_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t M[16] = {0}; // last 16 bytes followed by the constant padding words
+    unsigned int i, t;
+
+    M[4] = 0x80000000;
+    M[15] = 640; // length in bits
+    for(i=0; i<num_points/80; i++){
+        memcpy(hash + 8*i, H0, sizeof(H0));
+        sha256_process_blocks_generic(hash + 8*i, msg + 80*i, 1);
+        memcpy(M, msg + 80*i + 64, 16);
+        for(t=0; t<4; t++) M[t] = SWAP_UINT32(M[t]);
+        sha256_process_words_generic(hash + 8*i, M);
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_hash80_32u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                           0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    const __m256i INDEX = _mm256_set_epi32(140, 120, 100, 80, 60, 40, 20, 0); // word offsets of the messages
+    const uint8_t* blocks[8];
+    __m256i state[8], W[16];
+    unsigned int i, t;
+
+    for(i=0; i+8<=num_points/80; i+=8){
+        for(t=0; t<8; t++){
+            blocks[t] = msg + 80*(i+t);
+            state[t] = _mm256_set1_epi32(H0[t]);
+        }
+        sha256_process_block_x8_avx2(state, blocks, _mm256_set1_epi32(-1));
+
+        // Gather the last 16 bytes of the messages, the rest of the second block is constant
+        for(t=0; t<4; t++){
+            W[t] = _mm256_i32gather_epi32((const int*) (msg + 80*i + 64 + 4*t), INDEX, 4);
+            W[t] = _mm256_shuffle_epi8(W[t], MASK);
+        }
+        W[4] = _mm256_set1_epi32(0x80000000);
+        for(t=5; t<15; t++) W[t] = _mm256_setzero_si256();
+        W[15] = _mm256_set1_epi32(640); // length in bits
+        sha256_update_words_x8_avx2(state, W);
+
+        sha256_store_state_x8_avx2(hash + 8*i, state);
+    }
+
+    // Hash the remaining messages one by one
+    volk_sha256_8u_hash80_32u_generic(hash + 8*i, msg + 80*i, num_points - 80*i);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash80_32u_shani(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    const __m128i PAD0 = _mm_set_epi32(0, 0, 0, 0x80000000);
+    const __m128i PAD1 = _mm_set_epi32(640, 0, 0, 0); // length in bits
+    __m128i STATE0, STATE1;
+    unsigned int i;
+
+    sha256_shani_enter();
+
+    for(i=0; i<num_points/80; i++){
+        const __m128i* msg_block = (const __m128i*) (msg + 80*i);
+        sha256_load_state_shani(H0, &STATE0, &STATE1);
+        sha256_process_words_shani(&STATE0, &STATE1,
+                                   _mm_shuffle_epi8(_mm_loadu_si128(msg_block), MASK), _mm_shuffle_epi8(_mm_loadu_si128(msg_block+1), MASK),
+                                   _mm_shuffle_epi8(_mm_loadu_si128(msg_block+2), MASK), _mm_shuffle_epi8(_mm_loadu_si128(msg_block+3), MASK));
+        sha256_process_words_shani(&STATE0, &STATE1, _mm_shuffle_epi8(_mm_loadu_si128(msg_block+4), MASK),
+                                   PAD0, _mm_setzero_si128(), PAD1);
+        sha256_store_state_shani(hash + 8*i, STATE0, STATE1);
+    }
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash80_32u_a_H */
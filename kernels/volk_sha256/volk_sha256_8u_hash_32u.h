@@ -56,6 +56,67 @@ static const uint32_t K[64] = {
     0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
     0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
 
+/* Initial hash value H(0) */
+static const uint32_t H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/* Initial hash value H(0) of SHA-224, which runs the same compression and truncates to seven words */
+static const uint32_t H0_224[8] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4};
+
+/* Function processing N consecutive blocks of 512 bits */
+typedef void (*sha256_blocks_func_t)(uint32_t* hash, const uint8_t* msg, unsigned int N);
+
+/* Pad the rest bytes (R < 64) of a message into one or two blocks of 512 bits, returns the number of blocks */
+static inline unsigned int
+sha256_pad_tail(uint8_t* block, const uint8_t* rest, unsigned int R, uint64_t msg_len_bits){
+    unsigned int i;
+    const unsigned int n = (R < 56) ? 1 : 2; // the length needs the last 8 bytes of a block
+
+    memcpy(block, rest, R); // copy rest of message
+    block[R] = 0x80; // add 0x80 (1 followed by zeros) to message
+    memset(block + R + 1, 0x00, 64*n - 8 - (R + 1)); // set rest up to last 8 byte to zero
+
+    // write last 8 bytes with message length in bits in big endian format
+    for (i = 0; i < 8; i++) block[64*n - 1 - i] = msg_len_bits >> (i*8);
+
+    return n;
+}
+
+/* Maximum number of blocks handed to a block function at once, keeps N in unsigned int for 64 bit lengths */
+#define SHA256_MAX_BLOCKS_PER_CALL (1u << 24)
+
+/* Hash the rest of a message starting from the intermediate hash mid, which already covers the first
+ * prefix_len bytes (a multiple of 64) of the message, with a function processing blocks of 512 bits */
+static inline void
+sha256_hash_blocks_mid(uint32_t* hash, const uint32_t* mid, uint64_t prefix_len, const uint8_t* msg, uint64_t msg_len,
+                       sha256_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t tail[128]; // padding blocks
+    uint64_t N = msg_len / 64; // number of full 512 bit blocks
+    const uint8_t* rest = msg + 64*N;
+
+    memcpy(hash, mid, 8*sizeof(uint32_t));
+    for(; N > SHA256_MAX_BLOCKS_PER_CALL; N -= SHA256_MAX_BLOCKS_PER_CALL){
+        process_blocks(hash, msg, SHA256_MAX_BLOCKS_PER_CALL);
+        msg += 64*(uint64_t) SHA256_MAX_BLOCKS_PER_CALL;
+    }
+    process_blocks(hash, msg, (unsigned int) N);
+    process_blocks(hash, tail, sha256_pad_tail(tail, rest, msg_len % 64, (prefix_len + msg_len) * 8));
+}
+
+/* Hash a whole message starting from the initial hash iv with a function processing blocks of 512 bits */
+static inline void
+sha256_hash_blocks_iv(uint32_t* hash, const uint32_t* iv, const uint8_t* msg, uint64_t msg_len,
+                      sha256_blocks_func_t process_blocks){
+    sha256_hash_blocks_mid(hash, iv, 0, msg, msg_len, process_blocks);
+}
+
+/* Hash a whole message with a function processing blocks of 512 bits */
+static inline void
+sha256_hash_blocks(uint32_t* hash, const uint8_t* msg, uint64_t msg_len, sha256_blocks_func_t process_blocks){
+    sha256_hash_blocks_iv(hash, H0, msg, msg_len, process_blocks);
+}
+
 /* GENERIC: Single round in the sha256 main loop */
 #define	SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W, K) \
 T1 = h + EPSILON_1(e) + CH(e, f, g) + W + K;               \
@@ -255,6 +316,102 @@ sha256_process_block_generic(uint32_t* hash, const uint32_t* msg){
     hash[7] += h;
 }
 
+/* GENERIC: Process N consecutive blocks of 512 bits */
+static inline void
+sha256_process_blocks_generic(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    unsigned int i;
+    for(i=0; i<N; i++) sha256_process_block_generic(hash, (const uint32_t*) (msg + 64*i));
+}
+
+/* GENERIC: Single round on four interleaved messages. a to h index the rows of the state s, each row holds the
+ * word of all four messages side by side. With the constant round index t every index folds, and the loop over
+ * the messages is plain C the compiler can vectorize, or keeps as four independent chains where it cannot */
+#define SHA256_ROUND_ILP4_GENERIC(a, b, c, d, e, f, g, h, t)                                      \
+for(j=0; j<4; j++){                                                                               \
+    if((t) >= 16) W[(t) & 15][j] += SIGMA_1(W[((t) - 2) & 15][j]) + W[((t) - 7) & 15][j] +       \
+                                    SIGMA_0(W[((t) - 15) & 15][j]);                               \
+    T1[j] = s[h][j] + EPSILON_1(s[e][j]) + CH(s[e][j], s[f][j], s[g][j]) + W[(t) & 15][j] + K[t]; \
+    s[d][j] += T1[j];                                                                             \
+    s[h][j] = T1[j] + EPSILON_0(s[a][j]) + MAJ(s[a][j], s[b][j], s[c][j]);                        \
+}
+
+/* GENERIC: Eight rounds on four interleaved messages starting at the constant t */
+#define SHA256_ROUNDS8_ILP4_GENERIC(t)                                                            \
+SHA256_ROUND_ILP4_GENERIC(0, 1, 2, 3, 4, 5, 6, 7, (t));                                           \
+SHA256_ROUND_ILP4_GENERIC(7, 0, 1, 2, 3, 4, 5, 6, (t) + 1);                                       \
+SHA256_ROUND_ILP4_GENERIC(6, 7, 0, 1, 2, 3, 4, 5, (t) + 2);                                       \
+SHA256_ROUND_ILP4_GENERIC(5, 6, 7, 0, 1, 2, 3, 4, (t) + 3);                                       \
+SHA256_ROUND_ILP4_GENERIC(4, 5, 6, 7, 0, 1, 2, 3, (t) + 4);                                       \
+SHA256_ROUND_ILP4_GENERIC(3, 4, 5, 6, 7, 0, 1, 2, (t) + 5);                                       \
+SHA256_ROUND_ILP4_GENERIC(2, 3, 4, 5, 6, 7, 0, 1, (t) + 6);                                       \
+SHA256_ROUND_ILP4_GENERIC(1, 2, 3, 4, 5, 6, 7, 0, (t) + 7)
+
+/* GENERIC: Process one block of 512 bits of four messages with interleaved rounds, all 64 rounds unrolled.
+ * The dependency chains of the messages are independent, so they overlap in the SIMD unit or the out-of-order core */
+static inline void
+sha256_process_block_ilp4_generic(uint32_t (*hash)[8], const uint8_t* const* blocks){
+    uint32_t W[16][4], s[8][4], T1[4];
+    unsigned int i, j;
+
+    for(j=0; j<4; j++){
+        for(i=0; i<16; i++){
+            memcpy(&W[i][j], blocks[j] + 4*i, 4);
+            W[i][j] = SWAP_UINT32(W[i][j]);
+        }
+        for(i=0; i<8; i++) s[i][j] = hash[j][i];
+    }
+
+    SHA256_ROUNDS8_ILP4_GENERIC(0);
+    SHA256_ROUNDS8_ILP4_GENERIC(8);
+    SHA256_ROUNDS8_ILP4_GENERIC(16);
+    SHA256_ROUNDS8_ILP4_GENERIC(24);
+    SHA256_ROUNDS8_ILP4_GENERIC(32);
+    SHA256_ROUNDS8_ILP4_GENERIC(40);
+    SHA256_ROUNDS8_ILP4_GENERIC(48);
+    SHA256_ROUNDS8_ILP4_GENERIC(56);
+
+    // Get intermediate hash
+    for(j=0; j<4; j++) for(i=0; i<8; i++) hash[j][i] += s[i][j];
+}
+
+/* GENERIC: Hash count (a multiple of four) messages starting from the initial hash iv in groups of four messages
+ * with interleaved rounds. The groups run interleaved while all messages have blocks left, the rest of each message
+ * runs single-stream */
+static inline void
+sha256_hash_ilp4_generic(uint32_t* hash, const uint32_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens,
+                         unsigned int count){
+    __VOLK_ATTR_ALIGNED(16) uint8_t tail[4][128]; // padding blocks of each message
+    unsigned int N[4], N_total[4]; // number of full blocks and of blocks including padding of each message
+    const uint8_t* blocks[4];
+    unsigned int i, j, k, N_min;
+
+    for(i=0; i<count; i+=4){
+        uint32_t (*msg_hash)[8] = (uint32_t (*)[8]) (hash + 8*i);
+
+        // Pad each message of the group
+        N_min = ~0u;
+        for(j=0; j<4; j++){
+            N[j] = msg_lens[i+j] / 64;
+            N_total[j] = N[j] + sha256_pad_tail(tail[j], msgs[i+j] + 64*N[j], msg_lens[i+j] % 64, (uint64_t) msg_lens[i+j] * 8);
+            if(N_total[j] < N_min) N_min = N_total[j];
+            memcpy(msg_hash[j], iv, 8*sizeof(uint32_t));
+        }
+
+        // Interleaved rounds up to the shortest message
+        for(k=0; k<N_min; k++){
+            for(j=0; j<4; j++) blocks[j] = (k < N[j]) ? msgs[i+j] + 64*k : tail[j] + 64*(k - N[j]);
+            sha256_process_block_ilp4_generic(msg_hash, blocks);
+        }
+
+        // Finish the longer messages single-stream
+        for(j=0; j<4; j++){
+            if(N_min < N[j]) sha256_process_blocks_generic(msg_hash[j], msgs[i+j] + 64*N_min, N[j] - N_min);
+            k = (N_min > N[j]) ? N_min - N[j] : 0;
+            sha256_process_blocks_generic(msg_hash[j], tail[j] + 64*k, N_total[j] - N[j] - k);
+        }
+    }
+}
+
 #ifdef LV_HAVE_GENERIC
 
 static inline void
@@ -301,7 +458,7 @@ volk_sha256_8u_hash_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int
     }
 
     // write last 8 bytes with message length in bits in big endian format
-    const uint64_t msg_len_bits = msg_len*8;
+    const uint64_t msg_len_bits = (uint64_t) msg_len * 8;
     for (i = 0; i < 8; i++) msg_block_b[63 - i] = msg_len_bits >> (i*8);
 
     // update hash the last time
@@ -312,109 +469,1241 @@ volk_sha256_8u_hash_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int
 
 #endif /* LV_HAVE_GENERIC */
 
-/* SSE: Process one block of 512 bits in the sha256 main loop */
+/* BEGIN GENERATED BY gen/volk_sha256_unroll_gen.py, DO NOT EDIT */
+
+#ifdef LV_HAVE_GENERIC
+
+/* GENERIC: Process N consecutive blocks of 512 bits, one round per loop iteration */
+static inline void
+sha256_process_blocks_generic_rolled(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    uint32_t W[16];
+    uint32_t T1, T2;
+    uint32_t a, b, c, d, e, f, g, h;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 64*i, 64);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // Rounds 0 to 15 take the message words
+        for(t=0; t<16; t+=1){
+            W[t] = SWAP_UINT32(W[t]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t], K[t]);
+            T1 = a;
+            a = h;
+            h = g;
+            g = f;
+            f = e;
+            e = d;
+            d = c;
+            c = b;
+            b = T1;
+        }
+
+        // Rounds 16 to 63 calculate W in a ring of 16 words
+        for(t=16; t<64; t+=1){
+            W[t & 15] += SIGMA_1(W[(t + 14) & 15]) + W[(t + 9) & 15] + SIGMA_0(W[(t + 1) & 15]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t & 15], K[t]);
+            T1 = a;
+            a = h;
+            h = g;
+            g = f;
+            f = e;
+            e = d;
+            d = c;
+            c = b;
+            b = T1;
+        }
+
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+/* GENERIC: Process N consecutive blocks of 512 bits, 2 rounds per loop iteration */
 static inline void
-sha256_process_block_sse(uint32_t* hash, const uint32_t* msg){
-    uint32_t a, b, c, d, e, f, g, h, T1, T2, W[64];
+sha256_process_blocks_generic_unroll2(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    uint32_t W[16];
+    uint32_t T1, T2;
+    uint32_t a, b, c, d, e, f, g, h;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 64*i, 64);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // Rounds 0 to 15 take the message words
+        for(t=0; t<16; t+=2){
+            W[t] = SWAP_UINT32(W[t]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t], K[t]);
+            W[t + 1] = SWAP_UINT32(W[t + 1]);
+            SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[t + 1], K[t + 1]);
+            T1 = a;
+            a = g;
+            g = e;
+            e = c;
+            c = T1;
+            T1 = b;
+            b = h;
+            h = f;
+            f = d;
+            d = T1;
+        }
+
+        // Rounds 16 to 63 calculate W in a ring of 16 words
+        for(t=16; t<64; t+=2){
+            W[t & 15] += SIGMA_1(W[(t + 14) & 15]) + W[(t + 9) & 15] + SIGMA_0(W[(t + 1) & 15]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t & 15], K[t]);
+            W[(t + 1) & 15] += SIGMA_1(W[(t + 15) & 15]) + W[(t + 10) & 15] + SIGMA_0(W[(t + 2) & 15]);
+            SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[(t + 1) & 15], K[t + 1]);
+            T1 = a;
+            a = g;
+            g = e;
+            e = c;
+            c = T1;
+            T1 = b;
+            b = h;
+            h = f;
+            f = d;
+            d = T1;
+        }
+
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+/* GENERIC: Process N consecutive blocks of 512 bits, 4 rounds per loop iteration */
+static inline void
+sha256_process_blocks_generic_unroll4(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    uint32_t W[16];
+    uint32_t T1, T2;
+    uint32_t a, b, c, d, e, f, g, h;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 64*i, 64);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // Rounds 0 to 15 take the message words
+        for(t=0; t<16; t+=4){
+            W[t] = SWAP_UINT32(W[t]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t], K[t]);
+            W[t + 1] = SWAP_UINT32(W[t + 1]);
+            SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[t + 1], K[t + 1]);
+            W[t + 2] = SWAP_UINT32(W[t + 2]);
+            SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[t + 2], K[t + 2]);
+            W[t + 3] = SWAP_UINT32(W[t + 3]);
+            SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[t + 3], K[t + 3]);
+            T1 = a;
+            a = e;
+            e = T1;
+            T1 = b;
+            b = f;
+            f = T1;
+            T1 = c;
+            c = g;
+            g = T1;
+            T1 = d;
+            d = h;
+            h = T1;
+        }
+
+        // Rounds 16 to 63 calculate W in a ring of 16 words
+        for(t=16; t<64; t+=4){
+            W[t & 15] += SIGMA_1(W[(t + 14) & 15]) + W[(t + 9) & 15] + SIGMA_0(W[(t + 1) & 15]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t & 15], K[t]);
+            W[(t + 1) & 15] += SIGMA_1(W[(t + 15) & 15]) + W[(t + 10) & 15] + SIGMA_0(W[(t + 2) & 15]);
+            SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[(t + 1) & 15], K[t + 1]);
+            W[(t + 2) & 15] += SIGMA_1(W[(t + 16) & 15]) + W[(t + 11) & 15] + SIGMA_0(W[(t + 3) & 15]);
+            SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[(t + 2) & 15], K[t + 2]);
+            W[(t + 3) & 15] += SIGMA_1(W[(t + 17) & 15]) + W[(t + 12) & 15] + SIGMA_0(W[(t + 4) & 15]);
+            SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[(t + 3) & 15], K[t + 3]);
+            T1 = a;
+            a = e;
+            e = T1;
+            T1 = b;
+            b = f;
+            f = T1;
+            T1 = c;
+            c = g;
+            g = T1;
+            T1 = d;
+            d = h;
+            h = T1;
+        }
+
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+/* GENERIC: Process N consecutive blocks of 512 bits, 8 rounds per loop iteration */
+static inline void
+sha256_process_blocks_generic_unroll8(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    uint32_t W[16];
+    uint32_t T1, T2;
+    uint32_t a, b, c, d, e, f, g, h;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 64*i, 64);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // Rounds 0 to 15 take the message words
+        for(t=0; t<16; t+=8){
+            W[t] = SWAP_UINT32(W[t]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t], K[t]);
+            W[t + 1] = SWAP_UINT32(W[t + 1]);
+            SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[t + 1], K[t + 1]);
+            W[t + 2] = SWAP_UINT32(W[t + 2]);
+            SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[t + 2], K[t + 2]);
+            W[t + 3] = SWAP_UINT32(W[t + 3]);
+            SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[t + 3], K[t + 3]);
+            W[t + 4] = SWAP_UINT32(W[t + 4]);
+            SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[t + 4], K[t + 4]);
+            W[t + 5] = SWAP_UINT32(W[t + 5]);
+            SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[t + 5], K[t + 5]);
+            W[t + 6] = SWAP_UINT32(W[t + 6]);
+            SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[t + 6], K[t + 6]);
+            W[t + 7] = SWAP_UINT32(W[t + 7]);
+            SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[t + 7], K[t + 7]);
+        }
+
+        // Rounds 16 to 63 calculate W in a ring of 16 words
+        for(t=16; t<64; t+=8){
+            W[t & 15] += SIGMA_1(W[(t + 14) & 15]) + W[(t + 9) & 15] + SIGMA_0(W[(t + 1) & 15]);
+            SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[t & 15], K[t]);
+            W[(t + 1) & 15] += SIGMA_1(W[(t + 15) & 15]) + W[(t + 10) & 15] + SIGMA_0(W[(t + 2) & 15]);
+            SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[(t + 1) & 15], K[t + 1]);
+            W[(t + 2) & 15] += SIGMA_1(W[(t + 16) & 15]) + W[(t + 11) & 15] + SIGMA_0(W[(t + 3) & 15]);
+            SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[(t + 2) & 15], K[t + 2]);
+            W[(t + 3) & 15] += SIGMA_1(W[(t + 17) & 15]) + W[(t + 12) & 15] + SIGMA_0(W[(t + 4) & 15]);
+            SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[(t + 3) & 15], K[t + 3]);
+            W[(t + 4) & 15] += SIGMA_1(W[(t + 18) & 15]) + W[(t + 13) & 15] + SIGMA_0(W[(t + 5) & 15]);
+            SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[(t + 4) & 15], K[t + 4]);
+            W[(t + 5) & 15] += SIGMA_1(W[(t + 19) & 15]) + W[(t + 14) & 15] + SIGMA_0(W[(t + 6) & 15]);
+            SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[(t + 5) & 15], K[t + 5]);
+            W[(t + 6) & 15] += SIGMA_1(W[(t + 20) & 15]) + W[(t + 15) & 15] + SIGMA_0(W[(t + 7) & 15]);
+            SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[(t + 6) & 15], K[t + 6]);
+            W[(t + 7) & 15] += SIGMA_1(W[(t + 21) & 15]) + W[(t + 16) & 15] + SIGMA_0(W[(t + 8) & 15]);
+            SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[(t + 7) & 15], K[t + 7]);
+        }
+
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+/* GENERIC: Process N consecutive blocks of 512 bits, all 64 rounds unrolled */
+static inline void
+sha256_process_blocks_generic_unroll64(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    uint32_t W[16];
+    uint32_t T1, T2;
+    uint32_t a, b, c, d, e, f, g, h;
     unsigned int i;
 
-    // Calculate W
-    for (i = 0; i < 16; i++){
-        W[i] = SWAP_UINT32(msg[i]);
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 64*i, 64);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        W[0] = SWAP_UINT32(W[0]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[0], K[0]);
+        W[1] = SWAP_UINT32(W[1]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[1], K[1]);
+        W[2] = SWAP_UINT32(W[2]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[2], K[2]);
+        W[3] = SWAP_UINT32(W[3]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[3], K[3]);
+        W[4] = SWAP_UINT32(W[4]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[4], K[4]);
+        W[5] = SWAP_UINT32(W[5]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[5], K[5]);
+        W[6] = SWAP_UINT32(W[6]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[6], K[6]);
+        W[7] = SWAP_UINT32(W[7]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[7], K[7]);
+        W[8] = SWAP_UINT32(W[8]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[8], K[8]);
+        W[9] = SWAP_UINT32(W[9]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[9], K[9]);
+        W[10] = SWAP_UINT32(W[10]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[10], K[10]);
+        W[11] = SWAP_UINT32(W[11]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[11], K[11]);
+        W[12] = SWAP_UINT32(W[12]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[12], K[12]);
+        W[13] = SWAP_UINT32(W[13]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[13], K[13]);
+        W[14] = SWAP_UINT32(W[14]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[14], K[14]);
+        W[15] = SWAP_UINT32(W[15]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[15], K[15]);
+        W[0] += SIGMA_1(W[14]) + W[9] + SIGMA_0(W[1]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[0], K[16]);
+        W[1] += SIGMA_1(W[15]) + W[10] + SIGMA_0(W[2]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[1], K[17]);
+        W[2] += SIGMA_1(W[0]) + W[11] + SIGMA_0(W[3]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[2], K[18]);
+        W[3] += SIGMA_1(W[1]) + W[12] + SIGMA_0(W[4]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[3], K[19]);
+        W[4] += SIGMA_1(W[2]) + W[13] + SIGMA_0(W[5]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[4], K[20]);
+        W[5] += SIGMA_1(W[3]) + W[14] + SIGMA_0(W[6]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[5], K[21]);
+        W[6] += SIGMA_1(W[4]) + W[15] + SIGMA_0(W[7]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[6], K[22]);
+        W[7] += SIGMA_1(W[5]) + W[0] + SIGMA_0(W[8]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[7], K[23]);
+        W[8] += SIGMA_1(W[6]) + W[1] + SIGMA_0(W[9]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[8], K[24]);
+        W[9] += SIGMA_1(W[7]) + W[2] + SIGMA_0(W[10]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[9], K[25]);
+        W[10] += SIGMA_1(W[8]) + W[3] + SIGMA_0(W[11]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[10], K[26]);
+        W[11] += SIGMA_1(W[9]) + W[4] + SIGMA_0(W[12]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[11], K[27]);
+        W[12] += SIGMA_1(W[10]) + W[5] + SIGMA_0(W[13]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[12], K[28]);
+        W[13] += SIGMA_1(W[11]) + W[6] + SIGMA_0(W[14]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[13], K[29]);
+        W[14] += SIGMA_1(W[12]) + W[7] + SIGMA_0(W[15]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[14], K[30]);
+        W[15] += SIGMA_1(W[13]) + W[8] + SIGMA_0(W[0]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[15], K[31]);
+        W[0] += SIGMA_1(W[14]) + W[9] + SIGMA_0(W[1]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[0], K[32]);
+        W[1] += SIGMA_1(W[15]) + W[10] + SIGMA_0(W[2]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[1], K[33]);
+        W[2] += SIGMA_1(W[0]) + W[11] + SIGMA_0(W[3]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[2], K[34]);
+        W[3] += SIGMA_1(W[1]) + W[12] + SIGMA_0(W[4]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[3], K[35]);
+        W[4] += SIGMA_1(W[2]) + W[13] + SIGMA_0(W[5]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[4], K[36]);
+        W[5] += SIGMA_1(W[3]) + W[14] + SIGMA_0(W[6]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[5], K[37]);
+        W[6] += SIGMA_1(W[4]) + W[15] + SIGMA_0(W[7]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[6], K[38]);
+        W[7] += SIGMA_1(W[5]) + W[0] + SIGMA_0(W[8]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[7], K[39]);
+        W[8] += SIGMA_1(W[6]) + W[1] + SIGMA_0(W[9]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[8], K[40]);
+        W[9] += SIGMA_1(W[7]) + W[2] + SIGMA_0(W[10]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[9], K[41]);
+        W[10] += SIGMA_1(W[8]) + W[3] + SIGMA_0(W[11]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[10], K[42]);
+        W[11] += SIGMA_1(W[9]) + W[4] + SIGMA_0(W[12]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[11], K[43]);
+        W[12] += SIGMA_1(W[10]) + W[5] + SIGMA_0(W[13]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[12], K[44]);
+        W[13] += SIGMA_1(W[11]) + W[6] + SIGMA_0(W[14]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[13], K[45]);
+        W[14] += SIGMA_1(W[12]) + W[7] + SIGMA_0(W[15]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[14], K[46]);
+        W[15] += SIGMA_1(W[13]) + W[8] + SIGMA_0(W[0]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[15], K[47]);
+        W[0] += SIGMA_1(W[14]) + W[9] + SIGMA_0(W[1]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[0], K[48]);
+        W[1] += SIGMA_1(W[15]) + W[10] + SIGMA_0(W[2]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[1], K[49]);
+        W[2] += SIGMA_1(W[0]) + W[11] + SIGMA_0(W[3]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[2], K[50]);
+        W[3] += SIGMA_1(W[1]) + W[12] + SIGMA_0(W[4]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[3], K[51]);
+        W[4] += SIGMA_1(W[2]) + W[13] + SIGMA_0(W[5]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[4], K[52]);
+        W[5] += SIGMA_1(W[3]) + W[14] + SIGMA_0(W[6]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[5], K[53]);
+        W[6] += SIGMA_1(W[4]) + W[15] + SIGMA_0(W[7]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[6], K[54]);
+        W[7] += SIGMA_1(W[5]) + W[0] + SIGMA_0(W[8]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[7], K[55]);
+        W[8] += SIGMA_1(W[6]) + W[1] + SIGMA_0(W[9]);
+        SHA256_ROUND_GENERIC(a, b, c, d, e, f, g, h, W[8], K[56]);
+        W[9] += SIGMA_1(W[7]) + W[2] + SIGMA_0(W[10]);
+        SHA256_ROUND_GENERIC(h, a, b, c, d, e, f, g, W[9], K[57]);
+        W[10] += SIGMA_1(W[8]) + W[3] + SIGMA_0(W[11]);
+        SHA256_ROUND_GENERIC(g, h, a, b, c, d, e, f, W[10], K[58]);
+        W[11] += SIGMA_1(W[9]) + W[4] + SIGMA_0(W[12]);
+        SHA256_ROUND_GENERIC(f, g, h, a, b, c, d, e, W[11], K[59]);
+        W[12] += SIGMA_1(W[10]) + W[5] + SIGMA_0(W[13]);
+        SHA256_ROUND_GENERIC(e, f, g, h, a, b, c, d, W[12], K[60]);
+        W[13] += SIGMA_1(W[11]) + W[6] + SIGMA_0(W[14]);
+        SHA256_ROUND_GENERIC(d, e, f, g, h, a, b, c, W[13], K[61]);
+        W[14] += SIGMA_1(W[12]) + W[7] + SIGMA_0(W[15]);
+        SHA256_ROUND_GENERIC(c, d, e, f, g, h, a, b, W[14], K[62]);
+        W[15] += SIGMA_1(W[13]) + W[8] + SIGMA_0(W[0]);
+        SHA256_ROUND_GENERIC(b, c, d, e, f, g, h, a, W[15], K[63]);
+
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
     }
-    for (i = 16; i < 64; i++) W[i] = SIGMA_1(W[i-2]) + W[i-7] + SIGMA_0(W[i-15]) + W[i-16];
+}
 
-    // Init a to h
-    a = hash[0];
-    b = hash[1];
-    c = hash[2];
-    d = hash[3];
-    e = hash[4];
-    f = hash[5];
-    g = hash[6];
-    h = hash[7];
+#endif /* LV_HAVE_GENERIC */
 
-    // Run sha256 compression function
-    // NOTE: here goes the SSE magic! All other code is untouched compared to the generic version.
-    for(i=0; i<64; i++){
-        T1 = h + EPSILON_1(e) + CH(e, f, g) + K[i] + W[i];
-        T2 = EPSILON_0(a) + MAJ(a, b, c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + T1;
-        d = c;
-        c = b;
-        b = a;
-        a = T1 + T2;
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_32u_generic_rolled(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic_rolled);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_32u_generic_unroll2(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic_unroll2);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_32u_generic_unroll4(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic_unroll4);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_32u_generic_unroll8(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic_unroll8);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_32u_generic_unroll64(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic_unroll64);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+/* END GENERATED BY gen/volk_sha256_unroll_gen.py */
+
+/* Single round in the sha256 main loop with precomputed W + K */
+#define SHA256_ROUND_WK(a, b, c, d, e, f, g, h, WK) \
+T1 = h + EPSILON_1(e) + CH(e, f, g) + WK;           \
+d += T1;                                            \
+T2 = EPSILON_0(a) + MAJ(a, b, c);                   \
+h = T1 + T2
+
+/* Four rounds in the sha256 main loop with precomputed W + K */
+#define SHA256_ROUNDS4_WK(a, b, c, d, e, f, g, h, WK0, WK1, WK2, WK3) \
+SHA256_ROUND_WK(a, b, c, d, e, f, g, h, WK0);                         \
+SHA256_ROUND_WK(h, a, b, c, d, e, f, g, WK1);                         \
+SHA256_ROUND_WK(g, h, a, b, c, d, e, f, WK2);                         \
+SHA256_ROUND_WK(f, g, h, a, b, c, d, e, WK3)
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+/* SSE: Operations on four words */
+#define ROTR_SSE(x, n)      _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n))
+#define SIGMA_0_SSE(x)      _mm_xor_si128(_mm_xor_si128(ROTR_SSE(x, 7), ROTR_SSE(x, 18)), _mm_srli_epi32(x, 3))
+#define SIGMA_1_SSE(x)      _mm_xor_si128(_mm_xor_si128(ROTR_SSE(x, 17), ROTR_SSE(x, 19)), _mm_srli_epi32(x, 10))
+
+#endif /* LV_HAVE_SSE2 */
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+/* SSE: Load four words of a block in big endian format */
+static inline __m128i
+sha256_load_words_ssse3(const __m128i* msg, const int aligned){
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    return _mm_shuffle_epi8(aligned ? _mm_load_si128(msg) : _mm_loadu_si128(msg), MASK);
+}
+
+/* SSE: Calculate W[t..t+3] from X0 = W[t-16..t-13], X1 = W[t-12..t-9], X2 = W[t-8..t-5] and X3 = W[t-4..t-1] */
+static inline __m128i
+sha256_schedule_ssse3(__m128i X0, __m128i X1, __m128i X2, __m128i X3){
+    __m128i W;
+    W = _mm_add_epi32(X0, _mm_alignr_epi8(X3, X2, 4)); // W[t-16] + W[t-7]
+    W = _mm_add_epi32(W, SIGMA_0_SSE(_mm_alignr_epi8(X1, X0, 4))); // + SIGMA_0(W[t-15])
+    W = _mm_add_epi32(W, SIGMA_1_SSE(_mm_srli_si128(X3, 8))); // + SIGMA_1(W[t-2]), done for W[t] and W[t+1]
+    return _mm_add_epi32(W, SIGMA_1_SSE(_mm_slli_si128(W, 8))); // + SIGMA_1(W[t-2]) for W[t+2] and W[t+3]
+}
+
+/* SSSE3: Process N blocks of 512 bits with the message schedule in SSE registers */
+static inline void
+sha256_process_blocks_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int N, const int aligned){
+    __VOLK_ATTR_ALIGNED(16) uint32_t WK[64];
+    __m128i X0, X1, X2, X3;
+    uint32_t a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        const __m128i* msg_block = (const __m128i*) (msg + 64*i);
+
+        // Calculate W + K four words at once
+        X0 = sha256_load_words_ssse3(msg_block, aligned);
+        X1 = sha256_load_words_ssse3(msg_block+1, aligned);
+        X2 = sha256_load_words_ssse3(msg_block+2, aligned);
+        X3 = sha256_load_words_ssse3(msg_block+3, aligned);
+        for(t=0; t<64; t+=16){
+            _mm_store_si128((__m128i*) &WK[t], _mm_add_epi32(X0, _mm_loadu_si128((const __m128i*) &K[t])));
+            _mm_store_si128((__m128i*) &WK[t+4], _mm_add_epi32(X1, _mm_loadu_si128((const __m128i*) &K[t+4])));
+            _mm_store_si128((__m128i*) &WK[t+8], _mm_add_epi32(X2, _mm_loadu_si128((const __m128i*) &K[t+8])));
+            _mm_store_si128((__m128i*) &WK[t+12], _mm_add_epi32(X3, _mm_loadu_si128((const __m128i*) &K[t+12])));
+            if(t == 48) break;
+            X0 = sha256_schedule_ssse3(X0, X1, X2, X3);
+            X1 = sha256_schedule_ssse3(X1, X2, X3, X0);
+            X2 = sha256_schedule_ssse3(X2, X3, X0, X1);
+            X3 = sha256_schedule_ssse3(X3, X0, X1, X2);
+        }
+
+        // Init a to h
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // Run sha256 compression function
+        for(t=0; t<64; t+=8){
+            SHA256_ROUNDS4_WK(a, b, c, d, e, f, g, h, WK[t], WK[t+1], WK[t+2], WK[t+3]);
+            SHA256_ROUNDS4_WK(e, f, g, h, a, b, c, d, WK[t+4], WK[t+5], WK[t+6], WK[t+7]);
+        }
+
+        // Get intermediate hash
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
     }
+}
 
-    // Get intermediate hash
-    hash[0] = a + hash[0];
-    hash[1] = b + hash[1];
-    hash[2] = c + hash[2];
-    hash[3] = d + hash[3];
-    hash[4] = e + hash[4];
-    hash[5] = f + hash[5];
-    hash[6] = g + hash[6];
-    hash[7] = h + hash[7];
+static inline void
+sha256_process_blocks_a_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_ssse3(hash, msg, N, 1);
 }
 
-#ifdef LV_HAVE_SSE
+static inline void
+sha256_process_blocks_u_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_ssse3(hash, msg, N, 0);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSSE3
 
 static inline void
-volk_sha256_8u_hash_32u_a_sse(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+volk_sha256_8u_hash_32u_a_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
 {
-    /* INIT: Set initial hash */
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_ssse3);
+}
 
-    hash[0] = 0x6a09e667;
-    hash[1] = 0xbb67ae85;
-    hash[2] = 0x3c6ef372;
-    hash[3] = 0xa54ff53a;
-    hash[4] = 0x510e527f;
-    hash[5] = 0x9b05688c;
-    hash[6] = 0x1f83d9ab;
-    hash[7] = 0x5be0cd19;
+#endif /* LV_HAVE_SSSE3 */
 
-    /* MAIN LOOP: Process blocks of 512 bits without padding */
+#ifdef LV_HAVE_SSSE3
 
-    const unsigned int N = msg_len / 64; // number of full 512 bit blocks
+static inline void
+volk_sha256_8u_hash_32u_u_ssse3(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+/* SSE4.1: Four rounds taking W + K directly from a SSE register */
+#define SHA256_ROUNDS4_SSE4_1(a, b, c, d, e, f, g, h, WK)                   \
+SHA256_ROUNDS4_WK(a, b, c, d, e, f, g, h, _mm_extract_epi32(WK, 0),         \
+    _mm_extract_epi32(WK, 1), _mm_extract_epi32(WK, 2), _mm_extract_epi32(WK, 3))
+
+/* SSE4.1: Process N blocks of 512 bits with the message schedule interleaved with the rounds */
+static inline void
+sha256_process_blocks_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int N, const int aligned){
+    __m128i X0, X1, X2, X3, WK;
+    uint32_t a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        const __m128i* msg_block = (const __m128i*) (msg + 64*i);
+
+        X0 = sha256_load_words_ssse3(msg_block, aligned);
+        X1 = sha256_load_words_ssse3(msg_block+1, aligned);
+        X2 = sha256_load_words_ssse3(msg_block+2, aligned);
+        X3 = sha256_load_words_ssse3(msg_block+3, aligned);
+
+        // Init a to h
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        // Run rounds 0 to 47 while calculating the next four words of W
+        for(t=0; t<48; t+=16){
+            WK = _mm_add_epi32(X0, _mm_loadu_si128((const __m128i*) &K[t]));
+            X0 = sha256_schedule_ssse3(X0, X1, X2, X3);
+            SHA256_ROUNDS4_SSE4_1(a, b, c, d, e, f, g, h, WK);
+            WK = _mm_add_epi32(X1, _mm_loadu_si128((const __m128i*) &K[t+4]));
+            X1 = sha256_schedule_ssse3(X1, X2, X3, X0);
+            SHA256_ROUNDS4_SSE4_1(e, f, g, h, a, b, c, d, WK);
+            WK = _mm_add_epi32(X2, _mm_loadu_si128((const __m128i*) &K[t+8]));
+            X2 = sha256_schedule_ssse3(X2, X3, X0, X1);
+            SHA256_ROUNDS4_SSE4_1(a, b, c, d, e, f, g, h, WK);
+            WK = _mm_add_epi32(X3, _mm_loadu_si128((const __m128i*) &K[t+12]));
+            X3 = sha256_schedule_ssse3(X3, X0, X1, X2);
+            SHA256_ROUNDS4_SSE4_1(e, f, g, h, a, b, c, d, WK);
+        }
+
+        // Run rounds 48 to 63
+        WK = _mm_add_epi32(X0, _mm_loadu_si128((const __m128i*) &K[48]));
+        SHA256_ROUNDS4_SSE4_1(a, b, c, d, e, f, g, h, WK);
+        WK = _mm_add_epi32(X1, _mm_loadu_si128((const __m128i*) &K[52]));
+        SHA256_ROUNDS4_SSE4_1(e, f, g, h, a, b, c, d, WK);
+        WK = _mm_add_epi32(X2, _mm_loadu_si128((const __m128i*) &K[56]));
+        SHA256_ROUNDS4_SSE4_1(a, b, c, d, e, f, g, h, WK);
+        WK = _mm_add_epi32(X3, _mm_loadu_si128((const __m128i*) &K[60]));
+        SHA256_ROUNDS4_SSE4_1(e, f, g, h, a, b, c, d, WK);
+
+        // Get intermediate hash
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+static inline void
+sha256_process_blocks_a_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_sse4_1(hash, msg, N, 1);
+}
+
+static inline void
+sha256_process_blocks_u_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_sse4_1(hash, msg, N, 0);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_32u_a_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_32u_u_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Operations on eight words */
+#define ROTR_AVX2(x, n)         _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n))
+#define XOR3_AVX2(x, y, z)      _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define SIGMA_0_AVX2(x)         XOR3_AVX2(ROTR_AVX2(x, 7), ROTR_AVX2(x, 18), _mm256_srli_epi32(x, 3))
+#define SIGMA_1_AVX2(x)         XOR3_AVX2(ROTR_AVX2(x, 17), ROTR_AVX2(x, 19), _mm256_srli_epi32(x, 10))
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+#include <immintrin.h>
+
+/* BMI2: Single round with precomputed W + K, the rotations compile to rorx and CH uses andn.
+ * MAJ is calculated as b ^ ((a ^ b) & (b ^ c)), where b ^ c is a ^ b of the previous round */
+#define SHA256_ROUND_BMI2(a, b, c, d, e, f, g, h, WK, AB, BC)               \
+T1 = h + EPSILON_1(e) + ((e & f) + _andn_u32(e, g)) + WK;                   \
+AB = a ^ b;                                                                 \
+d += T1;                                                                    \
+T2 = EPSILON_0(a) + (b ^ (AB & BC));                                        \
+h = T1 + T2
+
+/* BMI2: Four rounds with precomputed W + K */
+#define SHA256_ROUNDS4_BMI2(a, b, c, d, e, f, g, h, WK)                     \
+SHA256_ROUND_BMI2(a, b, c, d, e, f, g, h, (WK)[0], AB, BC);                 \
+SHA256_ROUND_BMI2(h, a, b, c, d, e, f, g, (WK)[1], BC, AB);                 \
+SHA256_ROUND_BMI2(g, h, a, b, c, d, e, f, (WK)[2], AB, BC);                 \
+SHA256_ROUND_BMI2(f, g, h, a, b, c, d, e, (WK)[3], BC, AB)
+
+/* AVX2: Load four words of two blocks in big endian format, the first block goes to the lower lane */
+static inline __m256i
+sha256_load_words_x2_avx2(const uint8_t* msg0, const uint8_t* msg1, const int aligned){
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                           0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    const __m128i X0 = aligned ? _mm_load_si128((const __m128i*) msg0) : _mm_loadu_si128((const __m128i*) msg0);
+    const __m128i X1 = aligned ? _mm_load_si128((const __m128i*) msg1) : _mm_loadu_si128((const __m128i*) msg1);
+    return _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(X0), X1, 1), MASK);
+}
+
+/* AVX2: Calculate W[t..t+3] of two blocks at once, see sha256_schedule_ssse3 */
+static inline __m256i
+sha256_schedule_x2_avx2(__m256i X0, __m256i X1, __m256i X2, __m256i X3){
+    __m256i W;
+    W = _mm256_add_epi32(X0, _mm256_alignr_epi8(X3, X2, 4)); // W[t-16] + W[t-7]
+    W = _mm256_add_epi32(W, SIGMA_0_AVX2(_mm256_alignr_epi8(X1, X0, 4))); // + SIGMA_0(W[t-15])
+    W = _mm256_add_epi32(W, SIGMA_1_AVX2(_mm256_srli_si256(X3, 8))); // + SIGMA_1(W[t-2]), done for W[t] and W[t+1]
+    return _mm256_add_epi32(W, SIGMA_1_AVX2(_mm256_slli_si256(W, 8))); // + SIGMA_1(W[t-2]) for W[t+2] and W[t+3]
+}
+
+/* AVX2: Process N blocks of 512 bits, the message schedule of two consecutive blocks is calculated at once
+ * while running the rounds of the first block, the second block runs the rounds on the stored W + K */
+static inline void
+sha256_process_blocks_avx2_bmi2(uint32_t* hash, const uint8_t* msg, unsigned int N, const int aligned){
+    __VOLK_ATTR_ALIGNED(32) uint32_t WK[128]; // W + K of both blocks, four words of the first and the second block in turn
+    __m256i X0, X1, X2, X3;
+    uint32_t a, b, c, d, e, f, g, h, T1, T2, AB, BC;
+    unsigned int i, t;
+
+    for(i=0; i<N; i+=2){
+        const uint8_t* msg_block0 = msg + 64*i;
+        const uint8_t* msg_block1 = (i+1 < N) ? msg_block0 + 64 : msg_block0; // schedule the last block twice if N is odd
+
+        X0 = sha256_load_words_x2_avx2(msg_block0, msg_block1, aligned);
+        X1 = sha256_load_words_x2_avx2(msg_block0+16, msg_block1+16, aligned);
+        X2 = sha256_load_words_x2_avx2(msg_block0+32, msg_block1+32, aligned);
+        X3 = sha256_load_words_x2_avx2(msg_block0+48, msg_block1+48, aligned);
+
+        // Init a to h
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+        BC = b ^ c;
+
+        // Rounds of the first block while calculating the next four words of both blocks
+        for(t=0; t<64; t+=16){
+            _mm256_store_si256((__m256i*) &WK[2*t], _mm256_add_epi32(X0, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) &K[t]))));
+            _mm256_store_si256((__m256i*) &WK[2*t+8], _mm256_add_epi32(X1, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) &K[t+4]))));
+            _mm256_store_si256((__m256i*) &WK[2*t+16], _mm256_add_epi32(X2, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) &K[t+8]))));
+            _mm256_store_si256((__m256i*) &WK[2*t+24], _mm256_add_epi32(X3, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) &K[t+12]))));
+            if(t < 48){
+                X0 = sha256_schedule_x2_avx2(X0, X1, X2, X3);
+                X1 = sha256_schedule_x2_avx2(X1, X2, X3, X0);
+                X2 = sha256_schedule_x2_avx2(X2, X3, X0, X1);
+                X3 = sha256_schedule_x2_avx2(X3, X0, X1, X2);
+            }
+            SHA256_ROUNDS4_BMI2(a, b, c, d, e, f, g, h, &WK[2*t]);
+            SHA256_ROUNDS4_BMI2(e, f, g, h, a, b, c, d, &WK[2*t+8]);
+            SHA256_ROUNDS4_BMI2(a, b, c, d, e, f, g, h, &WK[2*t+16]);
+            SHA256_ROUNDS4_BMI2(e, f, g, h, a, b, c, d, &WK[2*t+24]);
+        }
+
+        // Get intermediate hash
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+
+        if(i+1 == N) break;
+
+        // Rounds of the second block on the already calculated W + K
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+        BC = b ^ c;
+
+        for(t=0; t<64; t+=8){
+            SHA256_ROUNDS4_BMI2(a, b, c, d, e, f, g, h, &WK[2*t+4]);
+            SHA256_ROUNDS4_BMI2(e, f, g, h, a, b, c, d, &WK[2*t+12]);
+        }
+
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+static inline void
+sha256_process_blocks_a_avx2_bmi2(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_avx2_bmi2(hash, msg, N, 1);
+}
+
+static inline void
+sha256_process_blocks_u_avx2_bmi2(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_avx2_bmi2(hash, msg, N, 0);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash_32u_a_avx2(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash_32u_u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+#include <immintrin.h>
+
+/* SHA-NI: Four rounds with the message words m */
+#define SHA256_SHANI_ROUNDS4(m, k)                                       \
+TMP = _mm_add_epi32(m, _mm_loadu_si128((const __m128i*) &K[k]));         \
+STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, TMP);                     \
+TMP = _mm_shuffle_epi32(TMP, 0x0E);                                      \
+STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, TMP)
+
+/* SHA-NI: Four rounds with the message words m0 while calculating the next words in m1 and preparing m3 */
+#define SHA256_SHANI_ROUNDS4_MSG(m0, m1, m3, k)                          \
+TMP = _mm_add_epi32(m0, _mm_loadu_si128((const __m128i*) &K[k]));        \
+STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, TMP);                     \
+m1 = _mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4));                      \
+m1 = _mm_sha256msg2_epu32(m1, m0);                                       \
+TMP = _mm_shuffle_epi32(TMP, 0x0E);                                      \
+STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, TMP);                     \
+m3 = _mm_sha256msg1_epu32(m3, m0)
+
+/* SHA-NI: Call before the first legacy SSE encoded instruction of a SHA-NI, assembly or generated code path.
+ * The SHA instructions have no VEX encoding, the vzeroupper avoids the SSE/AVX transition penalties in AVX
+ * machines. The "memory" clobber only keeps the compiler from moving memory accesses across the vzeroupper,
+ * it does not keep it from using ymm registers after it */
+static inline void
+sha256_shani_enter(void){
+#ifdef __AVX__
+    _mm256_zeroupper();
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/* SHA-NI: Reorder hash from DCBA, HGFE to the ABEF, CDGH layout of sha256rnds2 */
+static inline void
+sha256_load_state_shani(const uint32_t* hash, __m128i* STATE0, __m128i* STATE1){
+    const __m128i TMP = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &hash[0]), 0xB1); // CDAB
+    const __m128i EFGH = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &hash[4]), 0x1B); // EFGH
+    *STATE0 = _mm_alignr_epi8(TMP, EFGH, 8); // ABEF
+    *STATE1 = _mm_blend_epi16(EFGH, TMP, 0xF0); // CDGH
+}
+
+/* SHA-NI: Reorder back to DCBA, HGFE */
+static inline void
+sha256_store_state_shani(uint32_t* hash, __m128i STATE0, __m128i STATE1){
+    const __m128i TMP = _mm_shuffle_epi32(STATE0, 0x1B); // FEBA
+    STATE1 = _mm_shuffle_epi32(STATE1, 0xB1); // DCHG
+    _mm_storeu_si128((__m128i*) &hash[0], _mm_blend_epi16(TMP, STATE1, 0xF0)); // DCBA
+    _mm_storeu_si128((__m128i*) &hash[4], _mm_alignr_epi8(STATE1, TMP, 8)); // HGFE
+}
+
+/* SHA-NI: Process N blocks of 512 bits, the message is loaded with aligned loads if aligned is set */
+static inline void
+sha256_process_blocks_shani(uint32_t* hash, const uint8_t* msg, unsigned int N, const int aligned){
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    __m128i STATE0, STATE1, ABEF, CDGH, TMP, MSG0, MSG1, MSG2, MSG3;
     unsigned int i;
-    uint32_t* msg_block; // pointer to 512 bit blocks of input message
+
+    sha256_shani_enter();
+
+    sha256_load_state_shani(hash, &STATE0, &STATE1);
+
     for(i=0; i<N; i++){
-        msg_block = (uint32_t*) (msg + 64*i); // increment pointer to next multiple of 512 bits
-        sha256_process_block_sse(hash, msg_block); // process one main loop step
+        const __m128i* msg_block = (const __m128i*) (msg + 64*i);
+        ABEF = STATE0;
+        CDGH = STATE1;
+
+        // First 16 rounds take the message directly
+        MSG0 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block) : _mm_loadu_si128(msg_block), MASK);
+        SHA256_SHANI_ROUNDS4(MSG0, 0);
+        MSG1 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block+1) : _mm_loadu_si128(msg_block+1), MASK);
+        SHA256_SHANI_ROUNDS4(MSG1, 4);
+        MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
+        MSG2 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block+2) : _mm_loadu_si128(msg_block+2), MASK);
+        SHA256_SHANI_ROUNDS4(MSG2, 8);
+        MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
+        MSG3 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block+3) : _mm_loadu_si128(msg_block+3), MASK);
+
+        // Remaining rounds calculate W on the fly
+        SHA256_SHANI_ROUNDS4_MSG(MSG3, MSG0, MSG2, 12);
+        SHA256_SHANI_ROUNDS4_MSG(MSG0, MSG1, MSG3, 16);
+        SHA256_SHANI_ROUNDS4_MSG(MSG1, MSG2, MSG0, 20);
+        SHA256_SHANI_ROUNDS4_MSG(MSG2, MSG3, MSG1, 24);
+        SHA256_SHANI_ROUNDS4_MSG(MSG3, MSG0, MSG2, 28);
+        SHA256_SHANI_ROUNDS4_MSG(MSG0, MSG1, MSG3, 32);
+        SHA256_SHANI_ROUNDS4_MSG(MSG1, MSG2, MSG0, 36);
+        SHA256_SHANI_ROUNDS4_MSG(MSG2, MSG3, MSG1, 40);
+        SHA256_SHANI_ROUNDS4_MSG(MSG3, MSG0, MSG2, 44);
+        SHA256_SHANI_ROUNDS4_MSG(MSG0, MSG1, MSG3, 48);
+        SHA256_SHANI_ROUNDS4_MSG(MSG1, MSG2, MSG0, 52);
+        SHA256_SHANI_ROUNDS4_MSG(MSG2, MSG3, MSG1, 56);
+        SHA256_SHANI_ROUNDS4(MSG3, 60);
+
+        // Get intermediate hash
+        STATE0 = _mm_add_epi32(STATE0, ABEF);
+        STATE1 = _mm_add_epi32(STATE1, CDGH);
     }
 
-    /* PADDING AND LAST HASH UPDATE: Process rest of bits (msg_len%64 bytes) after processing of all 512 bits blocks */
+    sha256_store_state_shani(hash, STATE0, STATE1);
+}
 
-    const unsigned int R = msg_len % 64; // rest bytes from input message
-    size_t alignment = volk_sha256_get_alignment(); // get system alignment
-    msg_block = (uint32_t*) volk_sha256_malloc(4*16, alignment); // allocate 512 bits
-    uint8_t* msg_block_b = (uint8_t*) msg_block; // byte-wise pointer
+static inline void
+sha256_process_blocks_a_shani(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_shani(hash, msg, N, 1);
+}
 
-    memcpy(msg_block_b, msg+N*64, R); // copy rest of message to intermediate buffer
-    msg_block_b[R] = 0x80; // add 0x80 (1 followed by zeros) to message
+static inline void
+sha256_process_blocks_u_shani(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha256_process_blocks_shani(hash, msg, N, 0);
+}
 
-    if(R<56){ // if at least 8 bytes are free up to 512 bits, then set last 64 bit here
-        for(i=R+1; i<56; i++) msg_block_b[i] = 0x00; // set rest up to last 8 byte to zero
+/* SHA-NI: Four rounds on each of the interleaved messages */
+#define SHA256_SHANI_WAYS_ROUNDS4(m, k)                                  \
+for(j=0; j<ways; j++){                                                   \
+    TMP = _mm_add_epi32(m[j], _mm_loadu_si128((const __m128i*) &K[k]));  \
+    STATE1[j] = _mm_sha256rnds2_epu32(STATE1[j], STATE0[j], TMP);        \
+    TMP = _mm_shuffle_epi32(TMP, 0x0E);                                  \
+    STATE0[j] = _mm_sha256rnds2_epu32(STATE0[j], STATE1[j], TMP);        \
+}
+
+/* SHA-NI: Four rounds on each of the interleaved messages while calculating the next words */
+#define SHA256_SHANI_WAYS_ROUNDS4_MSG(m0, m1, m3, k)                     \
+for(j=0; j<ways; j++){                                                   \
+    TMP = _mm_add_epi32(m0[j], _mm_loadu_si128((const __m128i*) &K[k])); \
+    STATE1[j] = _mm_sha256rnds2_epu32(STATE1[j], STATE0[j], TMP);        \
+    m1[j] = _mm_add_epi32(m1[j], _mm_alignr_epi8(m0[j], m3[j], 4));      \
+    m1[j] = _mm_sha256msg2_epu32(m1[j], m0[j]);                          \
+    TMP = _mm_shuffle_epi32(TMP, 0x0E);                                  \
+    STATE0[j] = _mm_sha256rnds2_epu32(STATE0[j], STATE1[j], TMP);        \
+    m3[j] = _mm_sha256msg1_epu32(m3[j], m0[j]);                          \
+}
+
+/* SHA-NI: Process one block of up to four messages with interleaved rounds, so the latencies of sha256rnds2 overlap.
+ * The rounds run on local copies of the states, the caller's arrays may alias and would force a store per round */
+static inline void
+sha256_process_block_ways_shani(__m128i* state0, __m128i* state1, const uint8_t* const* blocks, const unsigned int ways){
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    __m128i STATE0[4], STATE1[4], ABEF[4], CDGH[4], MSG0[4], MSG1[4], MSG2[4], MSG3[4], TMP;
+    unsigned int j;
+
+    for(j=0; j<ways; j++){
+        STATE0[j] = ABEF[j] = state0[j];
+        STATE1[j] = CDGH[j] = state1[j];
+        MSG0[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) blocks[j]), MASK);
+        MSG1[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (blocks[j] + 16)), MASK);
+        MSG2[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (blocks[j] + 32)), MASK);
+        MSG3[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (blocks[j] + 48)), MASK);
     }
-    else{ // otherwise start a new block
-        for(i=R+1; i<64; i++) msg_block_b[i] = 0x00; // set rest to zero
-        sha256_process_block_sse(hash, msg_block); // update hash
-        for(i=0; i<56; i++) msg_block_b[i] = 0x00; // set rest up to last 8 byte to zero
+
+    // First 16 rounds take the message directly
+    SHA256_SHANI_WAYS_ROUNDS4(MSG0, 0);
+    SHA256_SHANI_WAYS_ROUNDS4(MSG1, 4);
+    for(j=0; j<ways; j++) MSG0[j] = _mm_sha256msg1_epu32(MSG0[j], MSG1[j]);
+    SHA256_SHANI_WAYS_ROUNDS4(MSG2, 8);
+    for(j=0; j<ways; j++) MSG1[j] = _mm_sha256msg1_epu32(MSG1[j], MSG2[j]);
+
+    // Remaining rounds calculate W on the fly
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG3, MSG0, MSG2, 12);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG0, MSG1, MSG3, 16);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG1, MSG2, MSG0, 20);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG2, MSG3, MSG1, 24);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG3, MSG0, MSG2, 28);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG0, MSG1, MSG3, 32);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG1, MSG2, MSG0, 36);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG2, MSG3, MSG1, 40);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG3, MSG0, MSG2, 44);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG0, MSG1, MSG3, 48);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG1, MSG2, MSG0, 52);
+    SHA256_SHANI_WAYS_ROUNDS4_MSG(MSG2, MSG3, MSG1, 56);
+    SHA256_SHANI_WAYS_ROUNDS4(MSG3, 60);
+
+    // Get intermediate hash
+    for(j=0; j<ways; j++){
+        state0[j] = _mm_add_epi32(STATE0[j], ABEF[j]);
+        state1[j] = _mm_add_epi32(STATE1[j], CDGH[j]);
     }
+}
 
-    // write last 8 bytes with message length in bits in big endian format
-    const uint64_t msg_len_bits = msg_len*8;
-    for (i = 0; i < 8; i++) msg_block_b[63 - i] = msg_len_bits >> (i*8);
+/* SHA-NI: Hash count messages starting from the initial hash iv in groups of ways (up to four) messages with
+ * interleaved rounds. The groups run interleaved while all messages have blocks left, the rest of each message
+ * runs single-stream */
+static inline void
+sha256_hash_ways_shani(uint32_t* hash, const uint32_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens,
+                       unsigned int count, const unsigned int ways){
+    __VOLK_ATTR_ALIGNED(16) uint8_t tail[4][128]; // padding blocks of each message
+    unsigned int N[4], N_total[4]; // number of full blocks and of blocks including padding of each message
+    const uint8_t* blocks[4];
+    __m128i STATE0[4], STATE1[4];
+    unsigned int i, j, k, N_min;
 
-    // update hash the last time
-    sha256_process_block_sse(hash, msg_block);
+    sha256_shani_enter();
 
-    volk_sha256_free(msg_block);
+    for(i=0; i<count; i+=ways){
+        // Pad each message of the group
+        N_min = ~0u;
+        for(j=0; j<ways; j++){
+            N[j] = msg_lens[i+j] / 64;
+            N_total[j] = N[j] + sha256_pad_tail(tail[j], msgs[i+j] + 64*N[j], msg_lens[i+j] % 64, (uint64_t) msg_lens[i+j] * 8);
+            if(N_total[j] < N_min) N_min = N_total[j];
+            sha256_load_state_shani(iv, &STATE0[j], &STATE1[j]);
+        }
+
+        // Interleaved rounds up to the shortest message
+        for(k=0; k<N_min; k++){
+            for(j=0; j<ways; j++) blocks[j] = (k < N[j]) ? msgs[i+j] + 64*k : tail[j] + 64*(k - N[j]);
+            sha256_process_block_ways_shani(STATE0, STATE1, blocks, ways);
+        }
+
+        // Finish the longer messages single-stream
+        for(j=0; j<ways; j++){
+            uint32_t* msg_hash = hash + 8*(i+j);
+            sha256_store_state_shani(msg_hash, STATE0[j], STATE1[j]);
+            if(N_min < N[j]) sha256_process_blocks_u_shani(msg_hash, msgs[i+j] + 64*N_min, N[j] - N_min);
+            k = (N_min > N[j]) ? N_min - N[j] : 0;
+            sha256_process_blocks_a_shani(msg_hash, tail[j] + 64*k, N_total[j] - N[j] - k);
+        }
+    }
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_32u_a_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_a_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_32u_u_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+#if defined(__x86_64__)
+/* SHA-NI block function in kernels/volk_sha256/asm/sha, takes aligned and unaligned messages */
+extern void sha256_process_blocks_shani_asm(uint32_t* hash, const uint8_t* msg, unsigned int N);
+#else
+/* The assembly is x86-64 only, 32-bit builds run the intrinsic block function instead */
+#define sha256_process_blocks_shani_asm sha256_process_blocks_u_shani
+#endif
+
+static inline void
+volk_sha256_8u_hash_32u_shani_asm(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_shani_enter();
+    sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_shani_asm);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+#include <volk_sha256/volk_sha256_jit.h>
+
+/* Calls the code generated by volk_sha256_jit_compile for this length, other lengths take the assembly */
+static inline void
+volk_sha256_8u_hash_32u_jit(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    const volk_sha256_jit_func_t jit_func = volk_sha256_jit_get(msg_len);
+    sha256_shani_enter();
+    if(jit_func) jit_func(hash, msg);
+    else sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_shani_asm);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+#include <volk_sha256/volk_sha256_prefetch.h>
+
+/* Number of blocks of 512 bits handed to the block function between two bursts of prefetches */
+#define SHA256_PREFETCH_CHUNK 16
+
+/* SSE: Hash a whole message much larger than the last level cache. Before each chunk is processed, the cache
+ * lines one prefetch distance ahead of it are requested with the non-temporal hint, so they arrive in time
+ * without the hardware prefetcher and do not evict the working set of the application from the outer caches */
+static inline void
+sha256_hash_blocks_prefetch(uint32_t* hash, const uint8_t* msg, uint64_t msg_len, sha256_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t tail[128]; // padding blocks
+    const uint64_t distance = volk_sha256_get_prefetch_distance();
+    const uint64_t size = msg_len & ~(uint64_t) 63; // bytes in full 512 bit blocks
+    uint64_t offset, k, ahead;
+    unsigned int n;
+
+    memcpy(hash, H0, sizeof(H0));
+
+    // The lines up to the first distance are requested before the first block
+    for(k = 0; k < distance && k < size; k += 64) _mm_prefetch((const char*) msg + k, _MM_HINT_NTA);
+
+    for(offset = 0; offset < size; offset += 64*n){
+        n = (size - offset > 64*SHA256_PREFETCH_CHUNK) ? SHA256_PREFETCH_CHUNK : (unsigned int) ((size - offset) / 64);
+        if(distance){
+            for(k = 0; k < 64*n; k += 64){
+                ahead = offset + distance + k;
+                if(ahead >= size) break;
+                _mm_prefetch((const char*) msg + ahead, _MM_HINT_NTA);
+            }
+        }
+        process_blocks(hash, msg + offset, n);
+    }
+    process_blocks(hash, tail, sha256_pad_tail(tail, msg + size, msg_len % 64, msg_len * 8));
 }
 
 #endif /* LV_HAVE_SSE */
 
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_32u_u_sse4_1_prefetch(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks_prefetch(hash, msg, msg_len, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash_32u_u_avx2_prefetch(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks_prefetch(hash, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_32u_u_shani_prefetch(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hash_blocks_prefetch(hash, msg, msg_len, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
 #endif /* INCLUDED_volk_sha256_8u_hash_32u_a_H */
@@ -0,0 +1,114 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <volk_sha256/volk_sha256_8u_x8_hash_32u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_x8_hash_32u for the QA and the profiler, which only know kernels on flat buffers.
+ * The num_points input bytes are split into eight messages of different lengths, the eight hashes are
+ * written to the first 64 words of the output.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash_lanes8_puppet_32u_H
+#define INCLUDED_volk_sha256_8u_hash_lanes8_puppet_32u_H
+
+/* Split a buffer into the messages of the lanes, the ragged lengths cover one and two padding blocks */
+static inline void
+sha256_puppet_split_lanes(const uint8_t** msgs, unsigned int* msg_lens, const uint8_t* msg, unsigned int num_points,
+                          unsigned int lanes){
+    const unsigned int chunk = num_points / lanes;
+    unsigned int i;
+
+    for(i=0; i<lanes; i++){
+        msgs[i] = msg + chunk*i;
+        msg_lens[i] = (chunk > 9*i) ? chunk - 9*i : 0;
+    }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_lanes8_puppet_32u_generic_ilp4(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* msgs[8];
+    unsigned int msg_lens[8];
+    sha256_puppet_split_lanes(msgs, msg_lens, msg, num_points, 8);
+    volk_sha256_8u_x8_hash_32u_generic_ilp4(hash, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_lanes8_puppet_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* msgs[8];
+    unsigned int msg_lens[8];
+    sha256_puppet_split_lanes(msgs, msg_lens, msg, num_points, 8);
+    volk_sha256_8u_x8_hash_32u_generic(hash, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_hash_lanes8_puppet_32u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* msgs[8];
+    unsigned int msg_lens[8];
+    sha256_puppet_split_lanes(msgs, msg_lens, msg, num_points, 8);
+    volk_sha256_8u_x8_hash_32u_avx2(hash, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_lanes8_puppet_32u_shani_2way(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* msgs[8];
+    unsigned int msg_lens[8];
+    sha256_puppet_split_lanes(msgs, msg_lens, msg, num_points, 8);
+    volk_sha256_8u_x8_hash_32u_shani_2way(hash, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_lanes8_puppet_32u_shani_4way(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* msgs[8];
+    unsigned int msg_lens[8];
+    sha256_puppet_split_lanes(msgs, msg_lens, msg, num_points, 8);
+    volk_sha256_8u_x8_hash_32u_shani_4way(hash, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash_lanes8_puppet_32u_H */
@@ -0,0 +1,147 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes a single message, tuned for messages of at most 55 bytes, which fit one padded block of 512 bits.
+ * The padded block is built on the stack without heap allocations and without branches on the length,
+ * the implementations only differ in the block function, so the call overhead stays as low as possible.
+ * Longer messages are handed to the multi-block path of volk_sha256_8u_hash_32u with a single branch,
+ * which is predictable for callers hashing messages of one length.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash_short_32u_a_H
+#define INCLUDED_volk_sha256_8u_hash_short_32u_a_H
+
+/* Maximum message length in bytes which fits one padded block */
+#define SHA256_SHORT_MAX_LEN 55
+
+/* Select a if mask is all ones and b if mask is zero, with bit operations instead of a branch */
+#define SHA256_SELECT_PTR(mask, a, b) ((const uint8_t*) (((uintptr_t) (a) & (mask)) | ((uintptr_t) (b) & ~(mask))))
+
+/* Copy n bytes if bit n is set in the length, otherwise copy zeros from the end of the block to a scratch buffer.
+ * The pointers are selected with masks, the fixed size memcpy compiles to plain moves */
+#define SHA256_SHORT_COPY(n)                                                                       \
+{                                                                                                  \
+    const uintptr_t take = -(uintptr_t) ((msg_len & n) != 0);                                      \
+    memcpy((uint8_t*) SHA256_SELECT_PTR(take, block + offset, scratch),                            \
+           SHA256_SELECT_PTR(take, msg + offset, block + 32), n);                                  \
+    offset += n & take;                                                                            \
+}
+
+/* Build the padded block of a message of at most 55 bytes without branches on the length.
+ * The message is copied in chunks of 32, 16, 8, 4, 2 and 1 bytes following the bits of the length,
+ * so only bytes within the message are read */
+static inline void
+sha256_pad_short(uint8_t* block, const uint8_t* msg, unsigned int msg_len){
+    uint8_t scratch[32]; // target of the skipped chunks
+    const uint32_t msg_len_bits[2] = {0, SWAP_UINT32(msg_len * 8)}; // big endian, the length fits 32 bits
+    unsigned int offset = 0;
+
+    memset(block, 0x00, 64);
+    SHA256_SHORT_COPY(32);
+    SHA256_SHORT_COPY(16);
+    SHA256_SHORT_COPY(8);
+    SHA256_SHORT_COPY(4);
+    SHA256_SHORT_COPY(2);
+    SHA256_SHORT_COPY(1);
+    block[msg_len] = 0x80; // add 0x80 (1 followed by zeros) to message
+
+    // write last 8 bytes with message length in bits in big endian format
+    memcpy(block + 56, msg_len_bits, 8);
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_short_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    __VOLK_ATTR_ALIGNED(16) uint8_t block[64]; // padded message
+    if(msg_len > SHA256_SHORT_MAX_LEN){
+        sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_generic);
+        return;
+    }
+    sha256_pad_short(block, msg, msg_len);
+    memcpy(hash, H0, sizeof(H0));
+    sha256_process_blocks_generic(hash, block, 1);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_short_32u_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    __VOLK_ATTR_ALIGNED(16) uint8_t block[64]; // padded message
+    if(msg_len > SHA256_SHORT_MAX_LEN){
+        sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_sse4_1);
+        return;
+    }
+    sha256_pad_short(block, msg, msg_len);
+    memcpy(hash, H0, sizeof(H0));
+    sha256_process_blocks_a_sse4_1(hash, block, 1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash_short_32u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    __VOLK_ATTR_ALIGNED(16) uint8_t block[64]; // padded message
+    if(msg_len > SHA256_SHORT_MAX_LEN){
+        sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+        return;
+    }
+    sha256_pad_short(block, msg, msg_len);
+    memcpy(hash, H0, sizeof(H0));
+    sha256_process_blocks_a_avx2_bmi2(hash, block, 1);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_short_32u_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    __VOLK_ATTR_ALIGNED(16) uint8_t block[64]; // padded message
+    if(msg_len > SHA256_SHORT_MAX_LEN){
+        sha256_hash_blocks(hash, msg, msg_len, sha256_process_blocks_u_shani);
+        return;
+    }
+    sha256_pad_short(block, msg, msg_len);
+    memcpy(hash, H0, sizeof(H0));
+    sha256_process_blocks_a_shani(hash, block, 1);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash_short_32u_a_H */
@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <volk_sha256/volk_sha256_8u_hash_short_32u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_hash_short_32u for the QA and the profiler, which only know kernels on flat buffers.
+ * Message i starts at byte 64*i of the input and has the length i%56, so all supported lengths are covered.
+ * The hash of message i is written to hash[8*i] to hash[8*i+7].
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hash_short_puppet_32u_H
+#define INCLUDED_volk_sha256_8u_hash_short_puppet_32u_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hash_short_puppet_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    unsigned int i;
+    for(i=0; i<num_points/64; i++){
+        volk_sha256_8u_hash_short_32u_generic(hash + 8*i, msg + 64*i, i % (SHA256_SHORT_MAX_LEN + 1));
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_short_puppet_32u_sse4_1(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    unsigned int i;
+    for(i=0; i<num_points/64; i++){
+        volk_sha256_8u_hash_short_32u_sse4_1(hash + 8*i, msg + 64*i, i % (SHA256_SHORT_MAX_LEN + 1));
+    }
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hash_short_puppet_32u_avx2(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    unsigned int i;
+    for(i=0; i<num_points/64; i++){
+        volk_sha256_8u_hash_short_32u_avx2(hash + 8*i, msg + 64*i, i % (SHA256_SHORT_MAX_LEN + 1));
+    }
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hash_short_puppet_32u_shani(uint32_t* hash, const uint8_t* msg, unsigned int num_points)
+{
+    unsigned int i;
+    for(i=0; i<num_points/64; i++){
+        volk_sha256_8u_hash_short_32u_shani(hash + 8*i, msg + 64*i, i % (SHA256_SHORT_MAX_LEN + 1));
+    }
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hash_short_puppet_32u_H */
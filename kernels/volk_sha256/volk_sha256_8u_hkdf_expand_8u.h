@@ -0,0 +1,230 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hmac_32u.h>
+#include <volk_sha256/volk_sha256_8u_hmac_verify_32u.h>
+#include <volk_sha256/volk_sha256_hkdf.h>
+
+/*
+ * NOTE:
+ * HKDF-Expand (RFC 5869) with HMAC-SHA256 for count sessions at once. Session i expands the 32 byte pseudorandom
+ * key prks[i] with the context infos[i] of info_lens[i] bytes to okm_len bytes of output keying material at
+ * okm[okm_len*i]. All sessions derive the same number of bytes. The one byte block counter limits okm_len to
+ * VOLK_SHA256_HKDF_MAX_OKM_LEN, the kernel writes nothing for longer outputs.
+ * The key states of the PRK are calculated in the kernel, they take two of the blocks per session. The messages
+ * T(t-1) | info | t are streamed block by block after the inner key state, so the context info has no limit.
+ * The AVX2 implementation runs eight sessions per batch, one per 32 bit lane, through the key setup and the
+ * blocks T(1), T(2), ... of the expansion.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hkdf_expand_8u_a_H
+#define INCLUDED_volk_sha256_8u_hkdf_expand_8u_a_H
+
+/* Number of blocks of 512 bits of the padded message T(t-1) | info | t after the key block */
+static inline unsigned int
+sha256_hkdf_num_blocks(unsigned int prev_len, unsigned int info_len){
+    return (unsigned int) (((uint64_t) prev_len + info_len + 1 + 8) / 64 + 1);
+}
+
+/* Copy the bytes of src, which starts at offset off of the message, that fall into the block starting at start */
+static inline void
+sha256_hkdf_copy_part(uint8_t* buf, uint64_t start, const uint8_t* src, uint64_t off, uint64_t len){
+    const uint64_t lo = (off > start) ? off : start;
+    const uint64_t hi = (off + len < start + 64) ? off + len : start + 64;
+    if(lo < hi) memcpy(buf + (lo - start), src + (lo - off), hi - lo);
+}
+
+/* Block k of the padded message T(t-1) | info | t after the key block. Blocks inside the context info are
+ * returned in place, the others are assembled in buf */
+static inline const uint8_t*
+sha256_hkdf_block(uint8_t* buf, unsigned int k, const uint8_t* prev, unsigned int prev_len,
+                  const uint8_t* info, unsigned int info_len, unsigned int t){
+    const uint64_t msg_len = (uint64_t) prev_len + info_len + 1;
+    const uint64_t start = 64*(uint64_t) k;
+    unsigned int i;
+
+    if(start >= prev_len && start + 64 <= prev_len + (uint64_t) info_len) return info + (start - prev_len);
+
+    memset(buf, 0x00, 64);
+    sha256_hkdf_copy_part(buf, start, prev, 0, prev_len);
+    sha256_hkdf_copy_part(buf, start, info, prev_len, info_len);
+    if(msg_len - 1 >= start && msg_len - 1 < start + 64) buf[msg_len - 1 - start] = (uint8_t) t;
+    if(msg_len >= start && msg_len < start + 64) buf[msg_len - start] = 0x80;
+
+    // The last block ends with the length in bits in big endian format
+    if(k + 1 == sha256_hkdf_num_blocks(prev_len, info_len)){
+        for(i=0; i<8; i++) buf[63 - i] = (uint8_t) (((SHA256_HMAC_BLOCK_LEN + msg_len) * 8) >> (i*8));
+    }
+    return buf;
+}
+
+/* Expand the sessions one after the other with a function processing blocks of 512 bits */
+static inline void
+sha256_hkdf_expand_blocks(uint8_t* okm, const uint8_t* const* prks, const uint8_t* const* infos,
+                          const unsigned int* info_lens, unsigned int okm_len, unsigned int count,
+                          sha256_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t buf[SHA256_HMAC_BLOCK_LEN];
+    uint8_t prev[32]; // T(t-1)
+    uint32_t key_state[16];
+    uint32_t inner[8], mac[8];
+    unsigned int i, k, t, N, len, prev_len;
+
+    if(okm_len > VOLK_SHA256_HKDF_MAX_OKM_LEN) return;
+
+    for(i=0; i<count; i++){
+        sha256_hmac_key_states_blocks(key_state, prks[i], VOLK_SHA256_HKDF_PRK_LEN, process_blocks);
+
+        // T(t) = HMAC(PRK, T(t-1) | info | t) with an empty T(0)
+        for(t=1; 32*(t-1) < okm_len; t++){
+            prev_len = (t == 1) ? 0 : 32;
+            N = sha256_hkdf_num_blocks(prev_len, info_lens[i]);
+            memcpy(inner, key_state, 8*sizeof(uint32_t));
+            for(k=0; k<N; k++) process_blocks(inner, sha256_hkdf_block(buf, k, prev, prev_len, infos[i], info_lens[i], t), 1);
+            sha256_hmac_outer_blocks(mac, key_state, inner, process_blocks);
+            for(k=0; k<8; k++) mac[k] = SWAP_UINT32(mac[k]);
+            memcpy(prev, mac, 32);
+
+            len = (okm_len - 32*(t-1) < 32) ? okm_len - 32*(t-1) : 32;
+            memcpy(okm + (size_t) okm_len * i + 32*(t-1), prev, len);
+        }
+    }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hkdf_expand_8u_generic(uint8_t* okm, const uint8_t* const* prks, const uint8_t* const* infos,
+                                      const unsigned int* info_lens, unsigned int okm_len, unsigned int count)
+{
+    sha256_hkdf_expand_blocks(okm, prks, infos, info_lens, okm_len, count, sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Expand eight sessions per batch, the last batch repeats the first session of the batch in the unused lanes */
+static inline void
+sha256_hkdf_expand_x8_avx2(uint8_t* okm, const uint8_t* const* prks, const uint8_t* const* infos,
+                           const unsigned int* info_lens, unsigned int okm_len, unsigned int count){
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                           0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    __VOLK_ATTR_ALIGNED(32) uint8_t bufs[8][SHA256_HMAC_BLOCK_LEN]; // assembled blocks of each lane
+    __VOLK_ATTR_ALIGNED(32) uint8_t prevs[8][32]; // T(t-1) of each lane
+    __VOLK_ATTR_ALIGNED(32) uint8_t pads[8][SHA256_HMAC_BLOCK_LEN]; // PRK xor ipad or opad of each lane
+    __VOLK_ATTR_ALIGNED(32) int32_t N[8]; // number of message blocks of each lane
+    const uint8_t* lane_pads[8];
+    const uint8_t* lane_blocks[8];
+    const uint8_t* lane_infos[8];
+    unsigned int lane_lens[8];
+    __m256i inner[8], outer[8], W[16], T[8], key, N_vec;
+    unsigned int i, j, k, n, t, len, prev_len, N_max;
+
+    if(okm_len > VOLK_SHA256_HKDF_MAX_OKM_LEN) return;
+
+    for(i=0; i<count; i+=8){
+        n = (count - i < 8) ? count - i : 8;
+
+        // Key blocks and contexts, session j of the batch goes to lane j
+        for(j=0; j<8; j++){
+            k = i + ((j < n) ? j : 0);
+            key = _mm256_loadu_si256((const __m256i*) prks[k]);
+            _mm256_store_si256((__m256i*) pads[j], _mm256_xor_si256(key, _mm256_set1_epi8(0x36)));
+            _mm256_store_si256((__m256i*) (pads[j] + 32), _mm256_set1_epi8(0x36));
+            lane_pads[j] = pads[j];
+            lane_infos[j] = infos[k];
+            lane_lens[j] = info_lens[k];
+        }
+
+        // Inner and outer key states of all lanes
+        for(j=0; j<8; j++) inner[j] = _mm256_set1_epi32(H0[j]);
+        sha256_process_block_x8_avx2(inner, lane_pads, _mm256_set1_epi32(-1));
+        for(j=0; j<8; j++){
+            _mm256_store_si256((__m256i*) pads[j], _mm256_xor_si256(_mm256_load_si256((const __m256i*) pads[j]),
+                                                                     _mm256_set1_epi8(0x36 ^ 0x5c)));
+            _mm256_store_si256((__m256i*) (pads[j] + 32), _mm256_set1_epi8(0x5c));
+        }
+        for(j=0; j<8; j++) outer[j] = _mm256_set1_epi32(H0[j]);
+        sha256_process_block_x8_avx2(outer, lane_pads, _mm256_set1_epi32(-1));
+
+        // T(t) = HMAC(PRK, T(t-1) | info | t) with an empty T(0) in all lanes
+        for(t=1; 32*(t-1) < okm_len; t++){
+            prev_len = (t == 1) ? 0 : 32;
+            N_max = 0;
+            for(j=0; j<8; j++){
+                N[j] = sha256_hkdf_num_blocks(prev_len, lane_lens[j]);
+                if((unsigned int) N[j] > N_max) N_max = N[j];
+            }
+            N_vec = _mm256_load_si256((const __m256i*) N);
+
+            // Inner hashes continue after the key block, finished lanes process a dummy block and keep their hash
+            for(j=0; j<8; j++) W[j] = inner[j];
+            for(k=0; k<N_max; k++){
+                for(j=0; j<8; j++){
+                    lane_blocks[j] = (k < (unsigned int) N[j]) ?
+                        sha256_hkdf_block(bufs[j], k, prevs[j], prev_len, lane_infos[j], lane_lens[j], t) : bufs[j];
+                }
+                sha256_process_block_x8_avx2(W, lane_blocks, _mm256_cmpgt_epi32(N_vec, _mm256_set1_epi32(k)));
+            }
+            sha256_hmac_outer_x8_avx2(T, W, outer);
+
+            // Transpose back to one block T(t) per session in network byte order
+            sha256_transpose8x8_avx2(T);
+            len = (okm_len - 32*(t-1) < 32) ? okm_len - 32*(t-1) : 32;
+            for(j=0; j<8; j++){
+                _mm256_store_si256((__m256i*) prevs[j], _mm256_shuffle_epi8(T[j], MASK));
+                if(j < n) memcpy(okm + (size_t) okm_len * (i+j) + 32*(t-1), prevs[j], len);
+            }
+        }
+    }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_hkdf_expand_8u_avx2(uint8_t* okm, const uint8_t* const* prks, const uint8_t* const* infos,
+                                   const unsigned int* info_lens, unsigned int okm_len, unsigned int count)
+{
+    sha256_hkdf_expand_x8_avx2(okm, prks, infos, info_lens, okm_len, count);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hkdf_expand_8u_shani(uint8_t* okm, const uint8_t* const* prks, const uint8_t* const* infos,
+                                    const unsigned int* info_lens, unsigned int okm_len, unsigned int count)
+{
+    sha256_hkdf_expand_blocks(okm, prks, infos, info_lens, okm_len, count, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hkdf_expand_8u_a_H */
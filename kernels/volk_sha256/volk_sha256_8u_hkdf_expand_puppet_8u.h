@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <volk_sha256/volk_sha256_8u_hkdf_expand_8u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_hkdf_expand_8u for the QA and the profiler, which only know kernels on flat buffers.
+ * The num_points input bytes are split into records of 128 bytes, each holding the PRK and the context of one
+ * session like a key schedule of a handshake. Every session derives 128 bytes, so the output keying material
+ * of all sessions fills the start of the output. The RFC 5869 test vectors are covered by
+ * qa_volk_sha256_8u_hkdf_expand_8u.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hkdf_expand_puppet_8u_H
+#define INCLUDED_volk_sha256_8u_hkdf_expand_puppet_8u_H
+
+#define SHA256_HKDF_PUPPET_RECORD_LEN 128
+#define SHA256_HKDF_PUPPET_INFO_LEN 40
+#define SHA256_HKDF_PUPPET_MAX_SESSIONS 256
+
+/* Split the input into the PRKs and contexts of the sessions, returns the number of sessions */
+static inline unsigned int
+sha256_hkdf_puppet_split(const uint8_t** prks, const uint8_t** infos, unsigned int* info_lens, const uint8_t* msg,
+                         unsigned int num_points){
+    unsigned int count = num_points / SHA256_HKDF_PUPPET_RECORD_LEN;
+    unsigned int i;
+
+    if(count > SHA256_HKDF_PUPPET_MAX_SESSIONS) count = SHA256_HKDF_PUPPET_MAX_SESSIONS;
+    for(i=0; i<count; i++){
+        prks[i] = msg + SHA256_HKDF_PUPPET_RECORD_LEN*i;
+        infos[i] = prks[i] + VOLK_SHA256_HKDF_PRK_LEN;
+        info_lens[i] = SHA256_HKDF_PUPPET_INFO_LEN;
+    }
+    return count;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hkdf_expand_puppet_8u_generic(uint8_t* okm, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* prks[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    const uint8_t* infos[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    unsigned int info_lens[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    unsigned int count = sha256_hkdf_puppet_split(prks, infos, info_lens, msg, num_points);
+    volk_sha256_8u_hkdf_expand_8u_generic(okm, prks, infos, info_lens, SHA256_HKDF_PUPPET_RECORD_LEN, count);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_hkdf_expand_puppet_8u_avx2(uint8_t* okm, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* prks[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    const uint8_t* infos[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    unsigned int info_lens[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    unsigned int count = sha256_hkdf_puppet_split(prks, infos, info_lens, msg, num_points);
+    volk_sha256_8u_hkdf_expand_8u_avx2(okm, prks, infos, info_lens, SHA256_HKDF_PUPPET_RECORD_LEN, count);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hkdf_expand_puppet_8u_shani(uint8_t* okm, const uint8_t* msg, unsigned int num_points)
+{
+    const uint8_t* prks[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    const uint8_t* infos[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    unsigned int info_lens[SHA256_HKDF_PUPPET_MAX_SESSIONS];
+    unsigned int count = sha256_hkdf_puppet_split(prks, infos, info_lens, msg, num_points);
+    volk_sha256_8u_hkdf_expand_8u_shani(okm, prks, infos, info_lens, SHA256_HKDF_PUPPET_RECORD_LEN, count);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hkdf_expand_puppet_8u_H */
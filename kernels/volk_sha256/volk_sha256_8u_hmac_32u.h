@@ -0,0 +1,203 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * HMAC-SHA256 of one message with a precomputed key, the MAC is written as eight words to mac[0] to mac[7].
+ * key_state holds the intermediate hash after the key block xor ipad in key_state[0..7] and after the key
+ * block xor opad in key_state[8..15], see volk_sha256_hmac_key_init. A MAC then costs the blocks of the
+ * message and one block of the outer hash, the same block functions as volk_sha256_8u_hash_32u are used.
+ * Reference: RFC 2104, test vectors of RFC 4231.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hmac_32u_a_H
+#define INCLUDED_volk_sha256_8u_hmac_32u_a_H
+
+/* Block length of SHA-256 in bytes, the key is padded or hashed to this length */
+#define SHA256_HMAC_BLOCK_LEN 64
+
+/* Calculate the intermediate hashes after the inner and the outer key block, key_state gets 16 words, with a
+ * function processing blocks of 512 bits */
+static inline void
+sha256_hmac_key_states_blocks(uint32_t* key_state, const uint8_t* key, unsigned int key_len,
+                              sha256_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t block[SHA256_HMAC_BLOCK_LEN];
+    uint32_t key_hash[8];
+    unsigned int i;
+
+    // Keys longer than a block are replaced by their hash
+    memset(block, 0x00, SHA256_HMAC_BLOCK_LEN);
+    if(key_len > SHA256_HMAC_BLOCK_LEN){
+        sha256_hash_blocks(key_hash, key, key_len, process_blocks);
+        for(i=0; i<8; i++) key_hash[i] = SWAP_UINT32(key_hash[i]);
+        memcpy(block, key_hash, sizeof(key_hash));
+    }
+    else if(key_len) memcpy(block, key, key_len);
+
+    for(i=0; i<SHA256_HMAC_BLOCK_LEN; i++) block[i] ^= 0x36;
+    memcpy(key_state, H0, 8*sizeof(uint32_t));
+    process_blocks(key_state, block, 1);
+
+    // Switch from ipad to opad
+    for(i=0; i<SHA256_HMAC_BLOCK_LEN; i++) block[i] ^= 0x36 ^ 0x5c;
+    memcpy(key_state + 8, H0, 8*sizeof(uint32_t));
+    process_blocks(key_state + 8, block, 1);
+}
+
+/* Calculate the intermediate hashes after the inner and the outer key block, key_state gets 16 words */
+static inline void
+sha256_hmac_key_states(uint32_t* key_state, const uint8_t* key, unsigned int key_len){
+    sha256_hmac_key_states_blocks(key_state, key, key_len, sha256_process_blocks_generic);
+}
+
+/* Calculate the MAC from the finished inner hash and the outer key state, the inner hash is byte swapped */
+static inline void
+sha256_hmac_outer_blocks(uint32_t* mac, const uint32_t* key_state, uint32_t* inner, sha256_blocks_func_t process_blocks){
+    __VOLK_ATTR_ALIGNED(64) uint8_t block[SHA256_HMAC_BLOCK_LEN];
+    unsigned int i;
+
+    // Outer hash of the inner hash in big endian format is a single block after the key block
+    for(i=0; i<8; i++) inner[i] = SWAP_UINT32(inner[i]);
+    sha256_pad_tail(block, (const uint8_t*) inner, 32, (SHA256_HMAC_BLOCK_LEN + 32) * 8);
+    memcpy(mac, key_state + 8, 8*sizeof(uint32_t));
+    process_blocks(mac, block, 1);
+}
+
+/* Calculate the MAC from the key states with a function processing blocks of 512 bits */
+static inline void
+sha256_hmac_blocks(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, uint64_t msg_len,
+                   sha256_blocks_func_t process_blocks){
+    uint32_t inner[8];
+
+    // Inner hash continues after the key block
+    sha256_hash_blocks_mid(inner, key_state, SHA256_HMAC_BLOCK_LEN, msg, msg_len, process_blocks);
+    sha256_hmac_outer_blocks(mac, key_state, inner, process_blocks);
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hmac_32u_generic(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hmac_32u_a_ssse3(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_a_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hmac_32u_u_ssse3(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_u_ssse3);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_32u_a_sse4_1(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_a_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_32u_u_sse4_1(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_u_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hmac_32u_a_avx2(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_a_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hmac_32u_u_avx2(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_u_avx2_bmi2);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_32u_a_shani(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_a_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_32u_u_shani(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_32u_shani_asm(uint32_t* mac, const uint32_t* key_state, const uint8_t* msg, unsigned int msg_len)
+{
+    sha256_shani_enter();
+    sha256_hmac_blocks(mac, key_state, msg, msg_len, sha256_process_blocks_shani_asm);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hmac_32u_a_H */
@@ -0,0 +1,167 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <volk_sha256/volk_sha256_8u_hmac_32u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_hmac_32u for the QA and the profiler, which only know kernels on flat buffers.
+ * The first 32 input bytes are the key and the rest is the message, the MAC goes to the first 8 words of
+ * the output. The key setup is part of the measured time, it is small against the default vector length.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hmac_puppet_32u_H
+#define INCLUDED_volk_sha256_8u_hmac_puppet_32u_H
+
+/* Number of input bytes taken as key */
+#define SHA256_HMAC_PUPPET_KEY_LEN 32
+
+/* Set up the key from the first bytes of the input, returns the number of bytes taken */
+static inline unsigned int
+sha256_hmac_puppet_key(uint32_t* key_state, const uint8_t* msg, unsigned int num_points){
+    const unsigned int key_len = (num_points < SHA256_HMAC_PUPPET_KEY_LEN) ? num_points : SHA256_HMAC_PUPPET_KEY_LEN;
+    sha256_hmac_key_states(key_state, msg, key_len);
+    return key_len;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_generic(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_generic(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_a_ssse3(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_a_ssse3(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_u_ssse3(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_u_ssse3(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_a_sse4_1(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_a_sse4_1(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_u_sse4_1(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_u_sse4_1(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_a_avx2(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_a_avx2(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_AVX2 && LV_HAVE_BMI2
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_u_avx2(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_u_avx2(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_AVX2 && LV_HAVE_BMI2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_a_shani(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_a_shani(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_u_shani(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_u_shani(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_puppet_32u_shani_asm(uint32_t* mac, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_state[16];
+    const unsigned int key_len = sha256_hmac_puppet_key(key_state, msg, num_points);
+    volk_sha256_8u_hmac_32u_shani_asm(mac, key_state, msg + key_len, num_points - key_len);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hmac_puppet_32u_H */
@@ -0,0 +1,176 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hmac_32u.h>
+#include <volk_sha256/volk_sha256_8u_x8_hash_32u.h>
+
+/*
+ * NOTE:
+ * Verifies the HMAC-SHA256 tags of count messages msgs[0..count-1] with the lengths msg_lens[0..count-1].
+ * Message i is checked with the key states key_states[i] (16 words, see volk_sha256_8u_hmac_32u), so
+ * messages may share a key or use different keys. The expected tag of message i is the 32 byte MAC in
+ * network byte order at tags[32*i]. Bit i%32 of pass[i/32] is set if the tag matches, the other bits of
+ * the (count+31)/32 words are cleared. The comparison does not stop at the first differing byte.
+ * The AVX2 implementation runs eight messages per batch, one per 32 bit lane, through the inner hash and
+ * the outer hash and compares the tags of all lanes at once.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hmac_verify_32u_a_H
+#define INCLUDED_volk_sha256_8u_hmac_verify_32u_a_H
+
+/* Compare a MAC with a tag in network byte order without early exit, returns 1 if they are equal */
+static inline unsigned int
+sha256_hmac_tag_equal(const uint32_t* mac, const uint8_t* tag){
+    uint32_t diff = 0;
+    unsigned int i;
+
+    for(i=0; i<8; i++){
+        diff |= mac[i] ^ (((uint32_t) tag[4*i] << 24) | ((uint32_t) tag[4*i+1] << 16) |
+                          ((uint32_t) tag[4*i+2] << 8) | (uint32_t) tag[4*i+3]);
+    }
+    return diff == 0;
+}
+
+/* Verify the messages one after the other with a function processing blocks of 512 bits */
+static inline void
+sha256_hmac_verify_blocks(uint32_t* pass, const uint32_t* const* key_states, const uint8_t* const* msgs,
+                          const unsigned int* msg_lens, const uint8_t* tags, unsigned int count,
+                          sha256_blocks_func_t process_blocks){
+    uint32_t mac[8];
+    unsigned int i;
+
+    memset(pass, 0x00, ((count + 31) / 32) * sizeof(uint32_t));
+    for(i=0; i<count; i++){
+        sha256_hmac_blocks(mac, key_states[i], msgs[i], msg_lens[i], process_blocks);
+        pass[i/32] |= sha256_hmac_tag_equal(mac, tags + 32*i) << (i%32);
+    }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hmac_verify_32u_generic(uint32_t* pass, const uint32_t* const* key_states, const uint8_t* const* msgs,
+                                       const unsigned int* msg_lens, const uint8_t* tags, unsigned int count)
+{
+    sha256_hmac_verify_blocks(pass, key_states, msgs, msg_lens, tags, count, sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Finish the MACs of eight lanes from the inner hashes in W[0..7] and the outer key states in lanes,
+ * W needs room for 16 words. mac gets the MAC words in lanes */
+static inline void
+sha256_hmac_outer_x8_avx2(__m256i* mac, __m256i* W, const __m256i* outer){
+    unsigned int j;
+
+    // The outer block is the inner hash and the padding for 96 bytes, the words are already in lanes
+    W[8] = _mm256_set1_epi32(0x80000000);
+    for(j=9; j<15; j++) W[j] = _mm256_setzero_si256();
+    W[15] = _mm256_set1_epi32((SHA256_HMAC_BLOCK_LEN + 32) * 8);
+    for(j=0; j<8; j++) mac[j] = outer[j];
+    sha256_rounds_x8_avx2(mac, W);
+    for(j=0; j<8; j++) mac[j] = _mm256_add_epi32(mac[j], outer[j]);
+}
+
+/* AVX2: HMAC of eight messages, one per lane, from the inner and outer key states in lanes (inner[w] holds word w
+ * of all lanes). mac gets the MAC words in lanes */
+static inline void
+sha256_hmac_lanes_x8_avx2(__m256i* mac, const __m256i* inner, const __m256i* outer, const uint8_t* const* msgs,
+                          const unsigned int* msg_lens){
+    __m256i W[16];
+    unsigned int j;
+
+    // Inner hash continues after the key block
+    for(j=0; j<8; j++) W[j] = inner[j];
+    sha256_run_lanes_x8_avx2(W, msgs, msg_lens, SHA256_HMAC_BLOCK_LEN, sha256_process_block_x8_avx2);
+    sha256_hmac_outer_x8_avx2(mac, W, outer);
+}
+
+/* AVX2: Verify eight messages per batch, the last batch repeats the first message of the batch in the unused lanes */
+static inline void
+sha256_hmac_verify_x8_avx2(uint32_t* pass, const uint32_t* const* key_states, const uint8_t* const* msgs,
+                           const unsigned int* msg_lens, const uint8_t* tags, unsigned int count){
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                           0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    const uint8_t* lane_msgs[8];
+    unsigned int lane_lens[8];
+    __m256i inner[8], outer[8], mac[8], T[8], equal;
+    unsigned int i, j, k, n;
+
+    memset(pass, 0x00, ((count + 31) / 32) * sizeof(uint32_t));
+    for(i=0; i<count; i+=8){
+        n = (count - i < 8) ? count - i : 8;
+
+        // Load the inner and outer key states and the tags as rows, message j of the batch goes to lane j
+        for(j=0; j<8; j++){
+            k = i + ((j < n) ? j : 0);
+            lane_msgs[j] = msgs[k];
+            lane_lens[j] = msg_lens[k];
+            inner[j] = _mm256_loadu_si256((const __m256i*) key_states[k]);
+            outer[j] = _mm256_loadu_si256((const __m256i*) (key_states[k] + 8));
+            T[j] = _mm256_loadu_si256((const __m256i*) (tags + 32*k));
+        }
+        sha256_transpose8x8_avx2(inner);
+        sha256_transpose8x8_avx2(outer);
+        sha256_transpose8x8_avx2(T);
+
+        sha256_hmac_lanes_x8_avx2(mac, inner, outer, lane_msgs, lane_lens);
+
+        // Compare all words of all lanes with the tags
+        equal = _mm256_set1_epi32(-1);
+        for(j=0; j<8; j++) equal = _mm256_and_si256(equal, _mm256_cmpeq_epi32(mac[j], _mm256_shuffle_epi8(T[j], MASK)));
+        pass[i/32] |= ((uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(equal)) & ((1u << n) - 1)) << (i%32);
+    }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_hmac_verify_32u_avx2(uint32_t* pass, const uint32_t* const* key_states, const uint8_t* const* msgs,
+                                    const unsigned int* msg_lens, const uint8_t* tags, unsigned int count)
+{
+    sha256_hmac_verify_x8_avx2(pass, key_states, msgs, msg_lens, tags, count);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_verify_32u_shani(uint32_t* pass, const uint32_t* const* key_states, const uint8_t* const* msgs,
+                                     const unsigned int* msg_lens, const uint8_t* tags, unsigned int count)
+{
+    sha256_hmac_verify_blocks(pass, key_states, msgs, msg_lens, tags, count, sha256_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hmac_verify_32u_a_H */
@@ -0,0 +1,107 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256_8u_hash_lanes8_puppet_32u.h>
+#include <volk_sha256/volk_sha256_8u_hmac_verify_32u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_hmac_verify_32u for the QA and the profiler, which only know kernels on flat buffers.
+ * The num_points input bytes are split into 20 messages under four keys taken from the start of the input,
+ * which leaves a partly filled last batch of eight lanes. The tags are also taken from the input, so they
+ * do not match and the bitmap is zero; the verification runs the same work for matching and wrong tags.
+ * The correct tags are covered by qa_volk_sha256_8u_hmac_verify_32u.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_hmac_verify_puppet_32u_H
+#define INCLUDED_volk_sha256_8u_hmac_verify_puppet_32u_H
+
+#define SHA256_HMAC_VERIFY_PUPPET_MSGS 20
+#define SHA256_HMAC_VERIFY_PUPPET_KEYS 4
+
+/* Split the input into keys, messages and tags */
+static inline void
+sha256_hmac_verify_puppet_split(uint8_t* tags, uint32_t (*key_states)[16], const uint32_t** msg_keys,
+                                const uint8_t** msgs, unsigned int* msg_lens, const uint8_t* msg, unsigned int num_points){
+    const unsigned int tag_len = (num_points < 32*SHA256_HMAC_VERIFY_PUPPET_MSGS) ? num_points : 32*SHA256_HMAC_VERIFY_PUPPET_MSGS;
+    unsigned int i;
+
+    for(i=0; i<SHA256_HMAC_VERIFY_PUPPET_KEYS; i++){
+        sha256_hmac_key_states(key_states[i], msg + ((num_points > 32*i) ? 32*i : 0), (num_points > 32*(i+1)) ? 32 : 0);
+    }
+    sha256_puppet_split_lanes(msgs, msg_lens, msg, num_points, SHA256_HMAC_VERIFY_PUPPET_MSGS);
+    for(i=0; i<SHA256_HMAC_VERIFY_PUPPET_MSGS; i++) msg_keys[i] = key_states[i % SHA256_HMAC_VERIFY_PUPPET_KEYS];
+    memset(tags, 0x00, 32*SHA256_HMAC_VERIFY_PUPPET_MSGS);
+    memcpy(tags, msg, tag_len);
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_hmac_verify_puppet_32u_generic(uint32_t* pass, const uint8_t* msg, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32) uint8_t tags[32*SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    uint32_t key_states[SHA256_HMAC_VERIFY_PUPPET_KEYS][16];
+    const uint32_t* msg_keys[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    const uint8_t* msgs[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    unsigned int msg_lens[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    sha256_hmac_verify_puppet_split(tags, key_states, msg_keys, msgs, msg_lens, msg, num_points);
+    volk_sha256_8u_hmac_verify_32u_generic(pass, msg_keys, msgs, msg_lens, tags, SHA256_HMAC_VERIFY_PUPPET_MSGS);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_hmac_verify_puppet_32u_avx2(uint32_t* pass, const uint8_t* msg, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32) uint8_t tags[32*SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    uint32_t key_states[SHA256_HMAC_VERIFY_PUPPET_KEYS][16];
+    const uint32_t* msg_keys[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    const uint8_t* msgs[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    unsigned int msg_lens[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    sha256_hmac_verify_puppet_split(tags, key_states, msg_keys, msgs, msg_lens, msg, num_points);
+    volk_sha256_8u_hmac_verify_32u_avx2(pass, msg_keys, msgs, msg_lens, tags, SHA256_HMAC_VERIFY_PUPPET_MSGS);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_hmac_verify_puppet_32u_shani(uint32_t* pass, const uint8_t* msg, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32) uint8_t tags[32*SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    uint32_t key_states[SHA256_HMAC_VERIFY_PUPPET_KEYS][16];
+    const uint32_t* msg_keys[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    const uint8_t* msgs[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    unsigned int msg_lens[SHA256_HMAC_VERIFY_PUPPET_MSGS];
+    sha256_hmac_verify_puppet_split(tags, key_states, msg_keys, msgs, msg_lens, msg, num_points);
+    volk_sha256_8u_hmac_verify_32u_shani(pass, msg_keys, msgs, msg_lens, tags, SHA256_HMAC_VERIFY_PUPPET_MSGS);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_hmac_verify_puppet_32u_H */
@@ -0,0 +1,420 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hmac_32u.h>
+#include <volk_sha256/volk_sha256_8u_hmac_verify_32u.h>
+#include <volk_sha256/volk_sha256_32u_hash_32u.h>
+#include <volk_sha256/volk_sha256_8u_x16_hash_32u.h>
+
+/*
+ * NOTE:
+ * PBKDF2-HMAC-SHA256 (RFC 8018) for count passwords at once. Password i is given by its HMAC key states
+ * key_states[i] (16 words, see volk_sha256_8u_hmac_32u) and derives dk_len bytes with the salt salts[i] of
+ * salt_lens[i] bytes and iterations (at least 1) rounds to dk[dk_len*i].
+ * The work is split into jobs of one 32 byte output block T_b of one password, so the SIMD lanes run
+ * independent passwords as well as independent output blocks of a single password.
+ * U_1 = HMAC(P, S | INT(b)) hashes the full blocks of the salt in place after the inner key state, only the
+ * rest of the salt and INT(b) are copied, so the salt has no limit. After U_1 every iteration U_n = HMAC(P, U_n-1) hashes a 32 byte message, its inner
+ * and outer blocks have constant padding words and start from the precomputed ipad and opad states, so one
+ * iteration is exactly two compressions on message words without any byte handling.
+ * The SHA-NI implementations run two jobs or one job at a time, shani_2way comes first so it is the default among
+ * the equal dependencies. The AVX2 and AVX-512 implementations run eight and sixteen jobs per batch, one per 32 bit
+ * lane.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_pbkdf2_8u_a_H
+#define INCLUDED_volk_sha256_8u_pbkdf2_8u_a_H
+
+/* Length in bits of the inner and outer messages of the iterations, the key block and a 32 byte message */
+#define SHA256_PBKDF2_ITER_LEN_BITS ((SHA256_HMAC_BLOCK_LEN + 32) * 8)
+
+/* Rest of the message S | INT(b) of the first iteration of output block b after the full blocks of the salt,
+ * salt_len is below 64, returns its length */
+static inline unsigned int
+sha256_pbkdf2_first_msg(uint8_t* msg, const uint8_t* salt, unsigned int salt_len, uint32_t b){
+    memcpy(msg, salt, salt_len);
+    msg[salt_len] = (uint8_t) (b >> 24);
+    msg[salt_len + 1] = (uint8_t) (b >> 16);
+    msg[salt_len + 2] = (uint8_t) (b >> 8);
+    msg[salt_len + 3] = (uint8_t) b;
+    return salt_len + 4;
+}
+
+/* Write output block T of a job in network byte order, the last block of a password may be cut */
+static inline void
+sha256_pbkdf2_store_block(uint8_t* dk, unsigned int dk_len, unsigned int job, unsigned int n_blocks,
+                          const uint32_t* T){
+    const unsigned int offset = 32*(job % n_blocks);
+    const unsigned int len = (dk_len - offset < 32) ? dk_len - offset : 32;
+    uint8_t* out = dk + dk_len*(job / n_blocks) + offset;
+    unsigned int k;
+
+    for(k=0; k<len; k++) out[k] = (uint8_t) (T[k/4] >> (24 - 8*(k%4)));
+}
+
+/* U_1 of a job with a function processing blocks of 512 bits */
+static inline void
+sha256_pbkdf2_first_blocks(uint32_t* U, const uint32_t* const* key_states, const uint8_t* const* salts,
+                           const unsigned int* salt_lens, unsigned int job, unsigned int n_blocks,
+                           sha256_blocks_func_t process_blocks){
+    uint8_t rest[64 + 4];
+    uint32_t mid[8], inner[8];
+    const unsigned int p = job / n_blocks;
+    const unsigned int N = salt_lens[p] / 64; // full blocks of the salt
+    const unsigned int len = sha256_pbkdf2_first_msg(rest, salts[p] + 64*N, salt_lens[p] % 64, job % n_blocks + 1);
+
+    memcpy(mid, key_states[p], 8*sizeof(uint32_t));
+    process_blocks(mid, salts[p], N);
+    sha256_hash_blocks_mid(inner, mid, SHA256_HMAC_BLOCK_LEN + 64*(uint64_t) N, rest, len, process_blocks);
+    sha256_hmac_outer_blocks(U, key_states[p], inner, process_blocks);
+}
+
+/* GENERIC: Iterations 2 to c of one job, U holds U_1 and T accumulates the xor of all U */
+static inline void
+sha256_pbkdf2_iterate_generic(uint32_t* T, uint32_t* U, const uint32_t* key_state, unsigned int iterations){
+    uint32_t M[16] = {0}; // U followed by the constant padding words
+    unsigned int n, k;
+
+    M[8] = 0x80000000;
+    M[15] = SHA256_PBKDF2_ITER_LEN_BITS;
+    for(n=1; n<iterations; n++){
+        memcpy(M, U, 32);
+        memcpy(U, key_state, 32);
+        sha256_process_words_generic(U, M);
+        memcpy(M, U, 32);
+        memcpy(U, key_state + 8, 32);
+        sha256_process_words_generic(U, M);
+        for(k=0; k<8; k++) T[k] ^= U[k];
+    }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_pbkdf2_8u_generic(uint8_t* dk, const uint32_t* const* key_states, const uint8_t* const* salts,
+                                 const unsigned int* salt_lens, unsigned int iterations, unsigned int dk_len,
+                                 unsigned int count)
+{
+    const unsigned int n_blocks = (dk_len + 31) / 32;
+    uint32_t T[8], U[8];
+    unsigned int q;
+
+    for(q=0; q<count*n_blocks; q++){
+        sha256_pbkdf2_first_blocks(U, key_states, salts, salt_lens, q, n_blocks, sha256_process_blocks_generic);
+        memcpy(T, U, 32);
+        sha256_pbkdf2_iterate_generic(T, U, key_states[q / n_blocks], iterations);
+        sha256_pbkdf2_store_block(dk, dk_len, q, n_blocks, T);
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+#include <immintrin.h>
+
+/* SHA-NI: Reorder a state in ABEF, CDGH to the words A to D and E to H of the next message */
+#define SHA256_PBKDF2_STATE_WORDS_SHANI(W0, W1, STATE0, STATE1) \
+TMP = _mm_shuffle_epi32(STATE0, 0x1B);                          \
+STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);                       \
+W0 = _mm_blend_epi16(TMP, STATE1, 0xF0);                        \
+W1 = _mm_alignr_epi8(STATE1, TMP, 8)
+
+/* SHA-NI: Iterations 2 to c of lanes jobs (one or two), the rounds of two jobs are issued alternately so
+ * the latency of sha256rnds2 of one job is hidden by the other */
+static inline void
+sha256_pbkdf2_iterate_shani(uint32_t* const* T, uint32_t* const* U, const uint32_t* const* key_states,
+                            unsigned int iterations, unsigned int lanes){
+    const __m128i PAD0 = _mm_set_epi32(0, 0, 0, 0x80000000);
+    const __m128i PAD1 = _mm_set_epi32(SHA256_PBKDF2_ITER_LEN_BITS, 0, 0, 0);
+    __m128i INNER0[2], INNER1[2], OUTER0[2], OUTER1[2], U0[2], U1[2], T0[2], T1[2], STATE0, STATE1, TMP;
+    unsigned int n, j;
+
+    sha256_shani_enter();
+
+    for(j=0; j<lanes; j++){
+        sha256_load_state_shani(key_states[j], &INNER0[j], &INNER1[j]);
+        sha256_load_state_shani(key_states[j] + 8, &OUTER0[j], &OUTER1[j]);
+        U0[j] = _mm_loadu_si128((const __m128i*) U[j]);
+        U1[j] = _mm_loadu_si128((const __m128i*) (U[j] + 4));
+        T0[j] = _mm_loadu_si128((const __m128i*) T[j]);
+        T1[j] = _mm_loadu_si128((const __m128i*) (T[j] + 4));
+    }
+
+    for(n=1; n<iterations; n++){
+        for(j=0; j<lanes; j++){
+            STATE0 = INNER0[j];
+            STATE1 = INNER1[j];
+            sha256_process_words_shani(&STATE0, &STATE1, U0[j], U1[j], PAD0, PAD1);
+            SHA256_PBKDF2_STATE_WORDS_SHANI(U0[j], U1[j], STATE0, STATE1);
+        }
+        for(j=0; j<lanes; j++){
+            STATE0 = OUTER0[j];
+            STATE1 = OUTER1[j];
+            sha256_process_words_shani(&STATE0, &STATE1, U0[j], U1[j], PAD0, PAD1);
+            SHA256_PBKDF2_STATE_WORDS_SHANI(U0[j], U1[j], STATE0, STATE1);
+            T0[j] = _mm_xor_si128(T0[j], U0[j]);
+            T1[j] = _mm_xor_si128(T1[j], U1[j]);
+        }
+    }
+
+    for(j=0; j<lanes; j++){
+        _mm_storeu_si128((__m128i*) T[j], T0[j]);
+        _mm_storeu_si128((__m128i*) (T[j] + 4), T1[j]);
+    }
+}
+
+/* SHA-NI: Run the jobs in groups of lanes jobs (one or two) */
+static inline void
+sha256_pbkdf2_shani(uint8_t* dk, const uint32_t* const* key_states, const uint8_t* const* salts,
+                    const unsigned int* salt_lens, unsigned int iterations, unsigned int dk_len,
+                    unsigned int count, unsigned int lanes){
+    const unsigned int n_blocks = (dk_len + 31) / 32;
+    const unsigned int n_jobs = count*n_blocks;
+    uint32_t T[2][8], U[2][8];
+    uint32_t* T_ptrs[2] = {T[0], T[1]};
+    uint32_t* U_ptrs[2] = {U[0], U[1]};
+    const uint32_t* job_keys[2];
+    unsigned int q, j, n;
+
+    for(q=0; q<n_jobs; q+=n){
+        n = (n_jobs - q < lanes) ? n_jobs - q : lanes;
+        for(j=0; j<n; j++){
+            sha256_pbkdf2_first_blocks(U[j], key_states, salts, salt_lens, q + j, n_blocks, sha256_process_blocks_u_shani);
+            memcpy(T[j], U[j], 32);
+            job_keys[j] = key_states[(q + j) / n_blocks];
+        }
+        sha256_pbkdf2_iterate_shani(T_ptrs, U_ptrs, job_keys, iterations, n);
+        for(j=0; j<n; j++) sha256_pbkdf2_store_block(dk, dk_len, q + j, n_blocks, T[j]);
+    }
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_pbkdf2_8u_shani_2way(uint8_t* dk, const uint32_t* const* key_states, const uint8_t* const* salts,
+                                    const unsigned int* salt_lens, unsigned int iterations, unsigned int dk_len,
+                                    unsigned int count)
+{
+    sha256_pbkdf2_shani(dk, key_states, salts, salt_lens, iterations, dk_len, count, 2);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_pbkdf2_8u_shani(uint8_t* dk, const uint32_t* const* key_states, const uint8_t* const* salts,
+                               const unsigned int* salt_lens, unsigned int iterations, unsigned int dk_len,
+                               unsigned int count)
+{
+    sha256_pbkdf2_shani(dk, key_states, salts, salt_lens, iterations, dk_len, count, 1);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: U_1 of eight jobs starting at job q, the last batch repeats job q in the unused lanes. inner and outer
+ * get the key states of the jobs in lanes */
+static inline void
+sha256_pbkdf2_first_x8_avx2(__m256i* U, __m256i* inner, __m256i* outer, const uint32_t* const* key_states,
+                            const uint8_t* const* salts, const unsigned int* salt_lens, unsigned int q,
+                            unsigned int n_jobs, unsigned int n_blocks){
+    __VOLK_ATTR_ALIGNED(32) uint8_t tails[8][3*64]; // rest of the salt, INT(b) and padding of each lane
+    __VOLK_ATTR_ALIGNED(32) int32_t N_total[8]; // number of blocks including padding of each lane
+    uint8_t rest[64 + 4];
+    const uint8_t* lane_salts[8];
+    const uint8_t* blocks[8];
+    unsigned int N[8]; // full blocks of the salt of each lane
+    __m256i W[16], N_vec;
+    unsigned int i, j, k, p, len, full, N_max = 0;
+
+    // The rest of the salt and INT(b) are padded lane-wise after the full blocks of the salt
+    for(j=0; j<8; j++){
+        k = (q + j < n_jobs) ? q + j : q;
+        p = k / n_blocks;
+        N[j] = salt_lens[p] / 64;
+        lane_salts[j] = salts[p];
+        len = sha256_pbkdf2_first_msg(rest, salts[p] + 64*N[j], salt_lens[p] % 64, k % n_blocks + 1);
+        full = len / 64;
+        memcpy(tails[j], rest, 64*full);
+        N_total[j] = N[j] + full + sha256_pad_tail(tails[j] + 64*full, rest + 64*full, len % 64,
+                                                   (SHA256_HMAC_BLOCK_LEN + 64*(uint64_t) N[j] + len) * 8);
+        if((unsigned int) N_total[j] > N_max) N_max = N_total[j];
+        inner[j] = _mm256_loadu_si256((const __m256i*) key_states[p]);
+        outer[j] = _mm256_loadu_si256((const __m256i*) (key_states[p] + 8));
+    }
+    sha256_transpose8x8_avx2(inner);
+    sha256_transpose8x8_avx2(outer);
+    N_vec = _mm256_load_si256((const __m256i*) N_total);
+
+    // Inner hashes continue after the key block, finished lanes process a dummy block and keep their hash
+    for(j=0; j<8; j++) W[j] = inner[j];
+    for(i=0; i<N_max; i++){
+        for(j=0; j<8; j++){
+            if(i < N[j]) blocks[j] = lane_salts[j] + 64*i;
+            else if(i < (unsigned int) N_total[j]) blocks[j] = tails[j] + 64*(i - N[j]);
+            else blocks[j] = tails[j];
+        }
+        sha256_process_block_x8_avx2(W, blocks, _mm256_cmpgt_epi32(N_vec, _mm256_set1_epi32(i)));
+    }
+    sha256_hmac_outer_x8_avx2(U, W, outer);
+}
+
+/* AVX2: Iterations 2 to c of eight jobs, U holds U_1 and T accumulates the xor of all U */
+static inline void
+sha256_pbkdf2_iterate_x8_avx2(__m256i* T, __m256i* U, const __m256i* inner, const __m256i* outer,
+                              unsigned int iterations){
+    __m256i W[16];
+    unsigned int n, j;
+
+    for(n=1; n<iterations; n++){
+        // Inner hash of U, the rounds overwrite W with the schedule so the padding words are set every time
+        for(j=0; j<8; j++) W[j] = U[j];
+        W[8] = _mm256_set1_epi32(0x80000000);
+        for(j=9; j<15; j++) W[j] = _mm256_setzero_si256();
+        W[15] = _mm256_set1_epi32(SHA256_PBKDF2_ITER_LEN_BITS);
+        for(j=0; j<8; j++) U[j] = inner[j];
+        sha256_update_words_x8_avx2(U, W);
+
+        // Outer hash of the inner hash
+        for(j=0; j<8; j++) W[j] = U[j];
+        W[8] = _mm256_set1_epi32(0x80000000);
+        for(j=9; j<15; j++) W[j] = _mm256_setzero_si256();
+        W[15] = _mm256_set1_epi32(SHA256_PBKDF2_ITER_LEN_BITS);
+        for(j=0; j<8; j++) U[j] = outer[j];
+        sha256_update_words_x8_avx2(U, W);
+
+        for(j=0; j<8; j++) T[j] = _mm256_xor_si256(T[j], U[j]);
+    }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_pbkdf2_8u_avx2(uint8_t* dk, const uint32_t* const* key_states, const uint8_t* const* salts,
+                              const unsigned int* salt_lens, unsigned int iterations, unsigned int dk_len,
+                              unsigned int count)
+{
+    const unsigned int n_blocks = (dk_len + 31) / 32;
+    const unsigned int n_jobs = count*n_blocks;
+    __m256i inner[8], outer[8], U[8], T[8];
+    uint32_t lanes[8][8];
+    unsigned int q, j;
+
+    for(q=0; q<n_jobs; q+=8){
+        sha256_pbkdf2_first_x8_avx2(U, inner, outer, key_states, salts, salt_lens, q, n_jobs, n_blocks);
+        for(j=0; j<8; j++) T[j] = U[j];
+        sha256_pbkdf2_iterate_x8_avx2(T, U, inner, outer, iterations);
+
+        // Transpose back to one output block per job
+        sha256_store_state_x8_avx2(lanes[0], T);
+        for(j=0; j<8 && q + j < n_jobs; j++) sha256_pbkdf2_store_block(dk, dk_len, q + j, n_blocks, lanes[j]);
+    }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_AVX512F && LV_HAVE_AVX2
+
+/* AVX-512: Iterations 2 to c of sixteen jobs, U holds U_1 and T accumulates the xor of all U */
+static inline void
+sha256_pbkdf2_iterate_x16_avx512f(__m512i* T, __m512i* U, const __m512i* inner, const __m512i* outer,
+                                  unsigned int iterations){
+    __m512i W[16], s[8];
+    unsigned int n, j;
+
+    for(n=1; n<iterations; n++){
+        // Inner hash of U, the rounds overwrite W with the schedule so the padding words are set every time
+        for(j=0; j<8; j++) W[j] = U[j];
+        W[8] = _mm512_set1_epi32(0x80000000);
+        for(j=9; j<15; j++) W[j] = _mm512_setzero_si512();
+        W[15] = _mm512_set1_epi32(SHA256_PBKDF2_ITER_LEN_BITS);
+        for(j=0; j<8; j++) s[j] = inner[j];
+        sha256_rounds_x16_avx512f(s, W);
+
+        // Outer hash of the inner hash
+        for(j=0; j<8; j++) W[j] = _mm512_add_epi32(inner[j], s[j]);
+        W[8] = _mm512_set1_epi32(0x80000000);
+        for(j=9; j<15; j++) W[j] = _mm512_setzero_si512();
+        W[15] = _mm512_set1_epi32(SHA256_PBKDF2_ITER_LEN_BITS);
+        for(j=0; j<8; j++) s[j] = outer[j];
+        sha256_rounds_x16_avx512f(s, W);
+
+        for(j=0; j<8; j++){
+            U[j] = _mm512_add_epi32(outer[j], s[j]);
+            T[j] = _mm512_xor_si512(T[j], U[j]);
+        }
+    }
+}
+
+#endif /* LV_HAVE_AVX512F && LV_HAVE_AVX2 */
+
+#if LV_HAVE_AVX512F && LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_pbkdf2_8u_avx512f(uint8_t* dk, const uint32_t* const* key_states, const uint8_t* const* salts,
+                                 const unsigned int* salt_lens, unsigned int iterations, unsigned int dk_len,
+                                 unsigned int count)
+{
+    const unsigned int n_blocks = (dk_len + 31) / 32;
+    const unsigned int n_jobs = count*n_blocks;
+    __m256i inner_lo[8], inner_hi[8], outer_lo[8], outer_hi[8], U_lo[8], U_hi[8];
+    __m512i inner[8], outer[8], U[8], T[8];
+    __VOLK_ATTR_ALIGNED(64) uint32_t lanes[8][16];
+    uint32_t block[8];
+    unsigned int q, j, k;
+
+    for(q=0; q<n_jobs; q+=16){
+        // U_1 is a message of any length, it runs on the AVX2 lanes in two halves
+        sha256_pbkdf2_first_x8_avx2(U_lo, inner_lo, outer_lo, key_states, salts, salt_lens, q, n_jobs, n_blocks);
+        sha256_pbkdf2_first_x8_avx2(U_hi, inner_hi, outer_hi, key_states, salts, salt_lens,
+                                    (q + 8 < n_jobs) ? q + 8 : q, n_jobs, n_blocks);
+        for(j=0; j<8; j++){
+            inner[j] = _mm512_inserti64x4(_mm512_castsi256_si512(inner_lo[j]), inner_hi[j], 1);
+            outer[j] = _mm512_inserti64x4(_mm512_castsi256_si512(outer_lo[j]), outer_hi[j], 1);
+            U[j] = _mm512_inserti64x4(_mm512_castsi256_si512(U_lo[j]), U_hi[j], 1);
+            T[j] = U[j];
+        }
+        sha256_pbkdf2_iterate_x16_avx512f(T, U, inner, outer, iterations);
+
+        // Word w of job j is in lane j of T[w]
+        for(j=0; j<8; j++) _mm512_store_si512((void*) lanes[j], T[j]);
+        for(j=0; j<16 && q + j < n_jobs; j++){
+            for(k=0; k<8; k++) block[k] = lanes[k][j];
+            sha256_pbkdf2_store_block(dk, dk_len, q + j, n_blocks, block);
+        }
+    }
+}
+
+#endif /* LV_HAVE_AVX512F && LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_sha256_8u_pbkdf2_8u_a_H */
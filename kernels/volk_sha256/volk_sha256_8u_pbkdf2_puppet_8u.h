@@ -0,0 +1,133 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <volk_sha256/volk_sha256_8u_pbkdf2_8u.h>
+
+/*
+ * NOTE:
+ * Puppet of volk_sha256_8u_pbkdf2_8u for the QA and the profiler, which only know kernels on flat buffers.
+ * The num_points input bytes are split into records of 32 bytes, each holding a password of 16 bytes and a
+ * salt of 16 bytes. Up to 20 passwords derive 32 bytes each with 100 iterations, which leaves partly filled
+ * last batches of eight and sixteen lanes. The derived keys fill the start of the output. The RFC 7914 test
+ * vectors are covered by qa_volk_sha256_8u_pbkdf2_8u.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_pbkdf2_puppet_8u_H
+#define INCLUDED_volk_sha256_8u_pbkdf2_puppet_8u_H
+
+#define SHA256_PBKDF2_PUPPET_PASSWORDS 20
+#define SHA256_PBKDF2_PUPPET_ITERATIONS 100
+
+/* Split the input into the key states and salts of the passwords, returns the number of passwords */
+static inline unsigned int
+sha256_pbkdf2_puppet_split(uint32_t (*key_states)[16], const uint32_t** keys, const uint8_t** salts,
+                           unsigned int* salt_lens, const uint8_t* msg, unsigned int num_points){
+    unsigned int count = num_points / 32;
+    unsigned int i;
+
+    if(count > SHA256_PBKDF2_PUPPET_PASSWORDS) count = SHA256_PBKDF2_PUPPET_PASSWORDS;
+    for(i=0; i<count; i++){
+        sha256_hmac_key_states(key_states[i], msg + 32*i, 16);
+        keys[i] = key_states[i];
+        salts[i] = msg + 32*i + 16;
+        salt_lens[i] = 16;
+    }
+    return count;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_pbkdf2_puppet_8u_generic(uint8_t* dk, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_states[SHA256_PBKDF2_PUPPET_PASSWORDS][16];
+    const uint32_t* keys[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    const uint8_t* salts[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int salt_lens[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int count = sha256_pbkdf2_puppet_split(key_states, keys, salts, salt_lens, msg, num_points);
+    volk_sha256_8u_pbkdf2_8u_generic(dk, keys, salts, salt_lens, SHA256_PBKDF2_PUPPET_ITERATIONS, 32, count);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_pbkdf2_puppet_8u_shani_2way(uint8_t* dk, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_states[SHA256_PBKDF2_PUPPET_PASSWORDS][16];
+    const uint32_t* keys[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    const uint8_t* salts[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int salt_lens[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int count = sha256_pbkdf2_puppet_split(key_states, keys, salts, salt_lens, msg, num_points);
+    volk_sha256_8u_pbkdf2_8u_shani_2way(dk, keys, salts, salt_lens, SHA256_PBKDF2_PUPPET_ITERATIONS, 32, count);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_pbkdf2_puppet_8u_shani(uint8_t* dk, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_states[SHA256_PBKDF2_PUPPET_PASSWORDS][16];
+    const uint32_t* keys[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    const uint8_t* salts[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int salt_lens[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int count = sha256_pbkdf2_puppet_split(key_states, keys, salts, salt_lens, msg, num_points);
+    volk_sha256_8u_pbkdf2_8u_shani(dk, keys, salts, salt_lens, SHA256_PBKDF2_PUPPET_ITERATIONS, 32, count);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_pbkdf2_puppet_8u_avx2(uint8_t* dk, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_states[SHA256_PBKDF2_PUPPET_PASSWORDS][16];
+    const uint32_t* keys[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    const uint8_t* salts[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int salt_lens[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int count = sha256_pbkdf2_puppet_split(key_states, keys, salts, salt_lens, msg, num_points);
+    volk_sha256_8u_pbkdf2_8u_avx2(dk, keys, salts, salt_lens, SHA256_PBKDF2_PUPPET_ITERATIONS, 32, count);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_AVX512F && LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_pbkdf2_puppet_8u_avx512f(uint8_t* dk, const uint8_t* msg, unsigned int num_points)
+{
+    uint32_t key_states[SHA256_PBKDF2_PUPPET_PASSWORDS][16];
+    const uint32_t* keys[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    const uint8_t* salts[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int salt_lens[SHA256_PBKDF2_PUPPET_PASSWORDS];
+    unsigned int count = sha256_pbkdf2_puppet_split(key_states, keys, salts, salt_lens, msg, num_points);
+    volk_sha256_8u_pbkdf2_8u_avx512f(dk, keys, salts, salt_lens, SHA256_PBKDF2_PUPPET_ITERATIONS, 32, count);
+}
+
+#endif /* LV_HAVE_AVX512F && LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_sha256_8u_pbkdf2_puppet_8u_H */
@@ -0,0 +1,318 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * SHA-1 of one message, the hash is written as five words to hash[0] to hash[4].
+ * SHA-1 is only provided to verify legacy data keyed by SHA-1 digests, it is not collision resistant.
+ * The padding is the one of SHA-256, so the message handling of volk_sha256_8u_hash_32u is reused with
+ * SHA-1 block functions which only touch the first five words of the state.
+ * Reference: FIPS 180-4, check against sha1sum.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_sha1_32u_a_H
+#define INCLUDED_volk_sha256_8u_sha1_32u_a_H
+
+/* Round constants of the four groups of 20 rounds */
+#define SHA1_K0 0x5a827999
+#define SHA1_K1 0x6ed9eba1
+#define SHA1_K2 0x8f1bbcdc
+#define SHA1_K3 0xca62c1d6
+
+/* Initial hash value H(0) of SHA-1, padded to the eight words handled by sha256_hash_blocks_iv */
+static const uint32_t H0_SHA1[8] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0, 0x00000000, 0x00000000, 0x00000000};
+
+/* Hash a whole message with a SHA-1 block function and write the five words of the hash */
+static inline void
+sha1_hash_blocks(uint32_t* hash, const uint8_t* msg, uint64_t msg_len, sha256_blocks_func_t process_blocks){
+    uint32_t state[8];
+    sha256_hash_blocks_iv(state, H0_SHA1, msg, msg_len, process_blocks);
+    memcpy(hash, state, 5*sizeof(uint32_t));
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/* GENERIC: Single round in the sha1 main loop, F is CH, PARITY or MAJ */
+#define SHA1_PARITY(x, y, z) ( (x) ^ (y) ^ (z) )
+#define SHA1_ROUND_GENERIC(a, b, c, d, e, F, K, W) \
+e += ROTL(a, 5) + F(b, c, d) + K + W;              \
+b = ROTL(b, 30)
+
+/* GENERIC: Calculate W[t] in place of W[t-16] */
+#define SHA1_SCHEDULE_GENERIC(W, t)                                     \
+T = W[((t)-3)&15] ^ W[((t)-8)&15] ^ W[((t)-14)&15] ^ W[(t)&15]; \
+W[(t)&15] = ROTL(T, 1)
+
+/* GENERIC: Five rounds of one group, renaming a to e back to their initial positions */
+#define SHA1_ROUNDS5_GENERIC(F, K, t)                                     \
+if((t) >= 16) { SHA1_SCHEDULE_GENERIC(W, t); }                            \
+SHA1_ROUND_GENERIC(a, b, c, d, e, F, K, W[(t)&15]);                       \
+if((t)+1 >= 16) { SHA1_SCHEDULE_GENERIC(W, (t)+1); }                      \
+SHA1_ROUND_GENERIC(e, a, b, c, d, F, K, W[((t)+1)&15]);                   \
+if((t)+2 >= 16) { SHA1_SCHEDULE_GENERIC(W, (t)+2); }                      \
+SHA1_ROUND_GENERIC(d, e, a, b, c, F, K, W[((t)+2)&15]);                   \
+if((t)+3 >= 16) { SHA1_SCHEDULE_GENERIC(W, (t)+3); }                      \
+SHA1_ROUND_GENERIC(c, d, e, a, b, F, K, W[((t)+3)&15]);                   \
+if((t)+4 >= 16) { SHA1_SCHEDULE_GENERIC(W, (t)+4); }                      \
+SHA1_ROUND_GENERIC(b, c, d, e, a, F, K, W[((t)+4)&15])
+
+/* GENERIC: Process N consecutive blocks of 512 bits, only hash[0] to hash[4] are used */
+static inline void
+sha1_process_blocks_generic(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    uint32_t W[16];
+    uint32_t T;
+    uint32_t a, b, c, d, e;
+    unsigned int i, t;
+
+    for(i=0; i<N; i++){
+        memcpy(W, msg + 64*i, 64);
+        for(t=0; t<16; t++) W[t] = SWAP_UINT32(W[t]);
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+
+        // Four groups of 20 rounds with their own function and constant, W is calculated in a ring of 16 words
+        for(t=0; t<20; t+=5){
+            SHA1_ROUNDS5_GENERIC(CH, SHA1_K0, t);
+        }
+        for(t=20; t<40; t+=5){
+            SHA1_ROUNDS5_GENERIC(SHA1_PARITY, SHA1_K1, t);
+        }
+        for(t=40; t<60; t+=5){
+            SHA1_ROUNDS5_GENERIC(MAJ, SHA1_K2, t);
+        }
+        for(t=60; t<80; t+=5){
+            SHA1_ROUNDS5_GENERIC(SHA1_PARITY, SHA1_K3, t);
+        }
+
+        // Get intermediate hash
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+    }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_sha1_32u_generic(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha1_hash_blocks(hash, msg, msg_len, sha1_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+#include <immintrin.h>
+
+/* SHA-NI: Four rounds with the message words m, e0 gets the next E from the current one and e1 saves ABCD */
+#define SHA1_SHANI_ROUNDS4(e0, e1, m, f)                                 \
+e0 = _mm_sha1nexte_epu32(e0, m);                                         \
+e1 = ABCD;                                                               \
+ABCD = _mm_sha1rnds4_epu32(ABCD, e0, f)
+
+/* SHA-NI: Process N blocks of 512 bits, the message is loaded with aligned loads if aligned is set */
+static inline void
+sha1_process_blocks_shani(uint32_t* hash, const uint8_t* msg, unsigned int N, const int aligned){
+    const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL); // reverse bytes, word 0 on top
+    __m128i ABCD, ABCD_SAVE, E0, E0_SAVE, E1, MSG0, MSG1, MSG2, MSG3;
+    unsigned int i;
+
+    sha256_shani_enter();
+
+    // sha1rnds4 keeps A in the highest word and E in the highest word of a separate register
+    ABCD = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) hash), 0x1B);
+    E0 = _mm_set_epi32(hash[4], 0, 0, 0);
+
+    for(i=0; i<N; i++){
+        const __m128i* msg_block = (const __m128i*) (msg + 64*i);
+        ABCD_SAVE = ABCD;
+        E0_SAVE = E0;
+
+        // Rounds 0 to 3
+        MSG0 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block) : _mm_loadu_si128(msg_block), MASK);
+        E0 = _mm_add_epi32(E0, MSG0);
+        E1 = ABCD;
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 0);
+
+        // Rounds 4 to 7
+        MSG1 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block+1) : _mm_loadu_si128(msg_block+1), MASK);
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG1, 0);
+        MSG0 = _mm_sha1msg1_epu32(MSG0, MSG1);
+
+        // Rounds 8 to 11
+        MSG2 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block+2) : _mm_loadu_si128(msg_block+2), MASK);
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG2, 0);
+        MSG1 = _mm_sha1msg1_epu32(MSG1, MSG2);
+        MSG0 = _mm_xor_si128(MSG0, MSG2);
+
+        // Rounds 12 to 15
+        MSG3 = _mm_shuffle_epi8(aligned ? _mm_load_si128(msg_block+3) : _mm_loadu_si128(msg_block+3), MASK);
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG3, 0);
+        MSG0 = _mm_sha1msg2_epu32(MSG0, MSG3);
+        MSG2 = _mm_sha1msg1_epu32(MSG2, MSG3);
+        MSG1 = _mm_xor_si128(MSG1, MSG3);
+
+        // Rounds 16 to 19
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG0, 0);
+        MSG1 = _mm_sha1msg2_epu32(MSG1, MSG0);
+        MSG3 = _mm_sha1msg1_epu32(MSG3, MSG0);
+        MSG2 = _mm_xor_si128(MSG2, MSG0);
+
+        // Rounds 20 to 23
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG1, 1);
+        MSG2 = _mm_sha1msg2_epu32(MSG2, MSG1);
+        MSG0 = _mm_sha1msg1_epu32(MSG0, MSG1);
+        MSG3 = _mm_xor_si128(MSG3, MSG1);
+
+        // Rounds 24 to 27
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG2, 1);
+        MSG3 = _mm_sha1msg2_epu32(MSG3, MSG2);
+        MSG1 = _mm_sha1msg1_epu32(MSG1, MSG2);
+        MSG0 = _mm_xor_si128(MSG0, MSG2);
+
+        // Rounds 28 to 31
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG3, 1);
+        MSG0 = _mm_sha1msg2_epu32(MSG0, MSG3);
+        MSG2 = _mm_sha1msg1_epu32(MSG2, MSG3);
+        MSG1 = _mm_xor_si128(MSG1, MSG3);
+
+        // Rounds 32 to 35
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG0, 1);
+        MSG1 = _mm_sha1msg2_epu32(MSG1, MSG0);
+        MSG3 = _mm_sha1msg1_epu32(MSG3, MSG0);
+        MSG2 = _mm_xor_si128(MSG2, MSG0);
+
+        // Rounds 36 to 39
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG1, 1);
+        MSG2 = _mm_sha1msg2_epu32(MSG2, MSG1);
+        MSG0 = _mm_sha1msg1_epu32(MSG0, MSG1);
+        MSG3 = _mm_xor_si128(MSG3, MSG1);
+
+        // Rounds 40 to 43
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG2, 2);
+        MSG3 = _mm_sha1msg2_epu32(MSG3, MSG2);
+        MSG1 = _mm_sha1msg1_epu32(MSG1, MSG2);
+        MSG0 = _mm_xor_si128(MSG0, MSG2);
+
+        // Rounds 44 to 47
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG3, 2);
+        MSG0 = _mm_sha1msg2_epu32(MSG0, MSG3);
+        MSG2 = _mm_sha1msg1_epu32(MSG2, MSG3);
+        MSG1 = _mm_xor_si128(MSG1, MSG3);
+
+        // Rounds 48 to 51
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG0, 2);
+        MSG1 = _mm_sha1msg2_epu32(MSG1, MSG0);
+        MSG3 = _mm_sha1msg1_epu32(MSG3, MSG0);
+        MSG2 = _mm_xor_si128(MSG2, MSG0);
+
+        // Rounds 52 to 55
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG1, 2);
+        MSG2 = _mm_sha1msg2_epu32(MSG2, MSG1);
+        MSG0 = _mm_sha1msg1_epu32(MSG0, MSG1);
+        MSG3 = _mm_xor_si128(MSG3, MSG1);
+
+        // Rounds 56 to 59
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG2, 2);
+        MSG3 = _mm_sha1msg2_epu32(MSG3, MSG2);
+        MSG1 = _mm_sha1msg1_epu32(MSG1, MSG2);
+        MSG0 = _mm_xor_si128(MSG0, MSG2);
+
+        // Rounds 60 to 63
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG3, 3);
+        MSG0 = _mm_sha1msg2_epu32(MSG0, MSG3);
+        MSG2 = _mm_sha1msg1_epu32(MSG2, MSG3);
+        MSG1 = _mm_xor_si128(MSG1, MSG3);
+
+        // Rounds 64 to 67
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG0, 3);
+        MSG1 = _mm_sha1msg2_epu32(MSG1, MSG0);
+        MSG3 = _mm_sha1msg1_epu32(MSG3, MSG0);
+        MSG2 = _mm_xor_si128(MSG2, MSG0);
+
+        // Rounds 68 to 71
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG1, 3);
+        MSG2 = _mm_sha1msg2_epu32(MSG2, MSG1);
+        MSG3 = _mm_xor_si128(MSG3, MSG1);
+
+        // Rounds 72 to 75
+        SHA1_SHANI_ROUNDS4(E0, E1, MSG2, 3);
+        MSG3 = _mm_sha1msg2_epu32(MSG3, MSG2);
+
+        // Rounds 76 to 79
+        SHA1_SHANI_ROUNDS4(E1, E0, MSG3, 3);
+        // Get intermediate hash
+        E0 = _mm_sha1nexte_epu32(E0, E0_SAVE);
+        ABCD = _mm_add_epi32(ABCD, ABCD_SAVE);
+    }
+
+    _mm_storeu_si128((__m128i*) hash, _mm_shuffle_epi32(ABCD, 0x1B));
+    hash[4] = _mm_extract_epi32(E0, 3);
+}
+
+static inline void
+sha1_process_blocks_a_shani(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha1_process_blocks_shani(hash, msg, N, 1);
+}
+
+static inline void
+sha1_process_blocks_u_shani(uint32_t* hash, const uint8_t* msg, unsigned int N){
+    sha1_process_blocks_shani(hash, msg, N, 0);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_sha1_32u_a_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha1_hash_blocks(hash, msg, msg_len, sha1_process_blocks_a_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_sha1_32u_u_shani(uint32_t* hash, const uint8_t* msg, unsigned int msg_len)
+{
+    sha1_hash_blocks(hash, msg, msg_len, sha1_process_blocks_u_shani);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_sha1_32u_a_H */
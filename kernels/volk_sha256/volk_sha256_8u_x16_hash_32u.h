@@ -0,0 +1,245 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+#include <volk_sha256/volk_sha256_8u_x8_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes sixteen independent messages msgs[0..15] with the lengths msg_lens[0..15] in bytes.
+ * The hash of message i is written to hash[8*i] to hash[8*i+7].
+ * The AVX-512 implementation runs one message per 32 bit lane of a ZMM register, the AVX2 implementation
+ * runs the 8-lane kernel twice and is kept as reference for the profiler.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x16_hash_32u_a_H
+#define INCLUDED_volk_sha256_8u_x16_hash_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x16_hash_32u_generic(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<16; i++) sha256_hash_blocks(hash + 8*i, msgs[i], msg_lens[i], sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_x16_hash_32u_avx2(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    volk_sha256_8u_x8_hash_32u_avx2(hash, msgs, msg_lens);
+    volk_sha256_8u_x8_hash_32u_avx2(hash + 64, msgs + 8, msg_lens + 8);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+
+/* AVX-512: Operations on sixteen words, one per lane, with vprord and vpternlogd */
+#define XOR3_AVX512(x, y, z)    _mm512_ternarylogic_epi32(x, y, z, 0x96)
+#define CH_AVX512(x, y, z)      _mm512_ternarylogic_epi32(x, y, z, 0xCA)
+#define MAJ_AVX512(x, y, z)     _mm512_ternarylogic_epi32(x, y, z, 0xE8)
+#define EPSILON_0_AVX512(x)     XOR3_AVX512(_mm512_ror_epi32(x, 2), _mm512_ror_epi32(x, 13), _mm512_ror_epi32(x, 22))
+#define EPSILON_1_AVX512(x)     XOR3_AVX512(_mm512_ror_epi32(x, 6), _mm512_ror_epi32(x, 11), _mm512_ror_epi32(x, 25))
+#define SIGMA_0_AVX512(x)       XOR3_AVX512(_mm512_ror_epi32(x, 7), _mm512_ror_epi32(x, 18), _mm512_srli_epi32(x, 3))
+#define SIGMA_1_AVX512(x)       XOR3_AVX512(_mm512_ror_epi32(x, 17), _mm512_ror_epi32(x, 19), _mm512_srli_epi32(x, 10))
+
+/* AVX-512: Single round in the sha256 main loop on sixteen messages */
+#define SHA256_ROUND_AVX512(a, b, c, d, e, f, g, h, W, k)                                       \
+T1 = _mm512_add_epi32(_mm512_add_epi32(h, EPSILON_1_AVX512(e)), _mm512_add_epi32(CH_AVX512(e, f, g), \
+    _mm512_add_epi32(W, _mm512_set1_epi32(K[k]))));                                             \
+d = _mm512_add_epi32(d, T1);                                                                    \
+T2 = _mm512_add_epi32(EPSILON_0_AVX512(a), MAJ_AVX512(a, b, c));                                \
+h = _mm512_add_epi32(T1, T2)
+
+/* AVX-512: Calculate W[t] in place of W[t-16] */
+#define SHA256_SCHEDULE_AVX512(W, t)                                                            \
+W[(t)&15] = _mm512_add_epi32(_mm512_add_epi32(SIGMA_1_AVX512(W[((t)-2)&15]), W[((t)-7)&15]),    \
+    _mm512_add_epi32(SIGMA_0_AVX512(W[((t)-15)&15]), W[(t)&15]))
+
+/* AVX-512: Transpose a 16x16 matrix of words, row i becomes lane i */
+static inline void
+sha256_transpose16x16_avx512f(__m512i* r){
+    __m512i t[16], AB, CD;
+    unsigned int i, j;
+
+    // Interleave words and pairs of words, chunk L of t[4*i+j] holds word 4*L+j of the rows 4*i to 4*i+3
+    for(i=0; i<16; i+=2){
+        t[i] = _mm512_unpacklo_epi32(r[i], r[i+1]);
+        t[i+1] = _mm512_unpackhi_epi32(r[i], r[i+1]);
+    }
+    for(i=0; i<16; i+=4){
+        r[i] = _mm512_unpacklo_epi64(t[i], t[i+2]);
+        r[i+1] = _mm512_unpackhi_epi64(t[i], t[i+2]);
+        r[i+2] = _mm512_unpacklo_epi64(t[i+1], t[i+3]);
+        r[i+3] = _mm512_unpackhi_epi64(t[i+1], t[i+3]);
+    }
+
+    // Gather the 128 bit chunks
+    for(j=0; j<4; j++){
+        AB = _mm512_shuffle_i32x4(r[j], r[4+j], 0x44);
+        CD = _mm512_shuffle_i32x4(r[8+j], r[12+j], 0x44);
+        t[j] = _mm512_shuffle_i32x4(AB, CD, 0x88);
+        t[4+j] = _mm512_shuffle_i32x4(AB, CD, 0xDD);
+        AB = _mm512_shuffle_i32x4(r[j], r[4+j], 0xEE);
+        CD = _mm512_shuffle_i32x4(r[8+j], r[12+j], 0xEE);
+        t[8+j] = _mm512_shuffle_i32x4(AB, CD, 0x88);
+        t[12+j] = _mm512_shuffle_i32x4(AB, CD, 0xDD);
+    }
+    for(i=0; i<16; i++) r[i] = t[i];
+}
+
+/* AVX-512: Run the 64 rounds on sixteen messages, s holds a to h and W the message words of all lanes */
+static inline void
+sha256_rounds_x16_avx512f(__m512i* s, __m512i* W){
+    __m512i a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int t;
+
+    // Init a to h
+    a = s[0];
+    b = s[1];
+    c = s[2];
+    d = s[3];
+    e = s[4];
+    f = s[5];
+    g = s[6];
+    h = s[7];
+
+    // First 16 rounds take the message directly
+    for(t=0; t<16; t+=8){
+        SHA256_ROUND_AVX512(a, b, c, d, e, f, g, h, W[t], t);
+        SHA256_ROUND_AVX512(h, a, b, c, d, e, f, g, W[t+1], t+1);
+        SHA256_ROUND_AVX512(g, h, a, b, c, d, e, f, W[t+2], t+2);
+        SHA256_ROUND_AVX512(f, g, h, a, b, c, d, e, W[t+3], t+3);
+        SHA256_ROUND_AVX512(e, f, g, h, a, b, c, d, W[t+4], t+4);
+        SHA256_ROUND_AVX512(d, e, f, g, h, a, b, c, W[t+5], t+5);
+        SHA256_ROUND_AVX512(c, d, e, f, g, h, a, b, W[t+6], t+6);
+        SHA256_ROUND_AVX512(b, c, d, e, f, g, h, a, W[t+7], t+7);
+    }
+
+    // Remaining rounds calculate W on the fly
+    for(t=16; t<64; t+=8){
+        SHA256_SCHEDULE_AVX512(W, t);
+        SHA256_ROUND_AVX512(a, b, c, d, e, f, g, h, W[t&15], t);
+        SHA256_SCHEDULE_AVX512(W, t+1);
+        SHA256_ROUND_AVX512(h, a, b, c, d, e, f, g, W[(t+1)&15], t+1);
+        SHA256_SCHEDULE_AVX512(W, t+2);
+        SHA256_ROUND_AVX512(g, h, a, b, c, d, e, f, W[(t+2)&15], t+2);
+        SHA256_SCHEDULE_AVX512(W, t+3);
+        SHA256_ROUND_AVX512(f, g, h, a, b, c, d, e, W[(t+3)&15], t+3);
+        SHA256_SCHEDULE_AVX512(W, t+4);
+        SHA256_ROUND_AVX512(e, f, g, h, a, b, c, d, W[(t+4)&15], t+4);
+        SHA256_SCHEDULE_AVX512(W, t+5);
+        SHA256_ROUND_AVX512(d, e, f, g, h, a, b, c, W[(t+5)&15], t+5);
+        SHA256_SCHEDULE_AVX512(W, t+6);
+        SHA256_ROUND_AVX512(c, d, e, f, g, h, a, b, W[(t+6)&15], t+6);
+        SHA256_SCHEDULE_AVX512(W, t+7);
+        SHA256_ROUND_AVX512(b, c, d, e, f, g, h, a, W[(t+7)&15], t+7);
+    }
+
+    s[0] = a;
+    s[1] = b;
+    s[2] = c;
+    s[3] = d;
+    s[4] = e;
+    s[5] = f;
+    s[6] = g;
+    s[7] = h;
+}
+
+/* AVX-512: Process one block of 512 bits of sixteen messages, the hash is only updated in the active lanes */
+static inline void
+sha256_process_block_x16_avx512f(__m512i* state, const uint8_t* const* blocks, __mmask16 active){
+    const __m512i MASK = _mm512_set1_epi32(0xff00ff00);
+    __m512i W[16], s[8];
+    unsigned int i, t;
+
+    // Load the blocks as rows and transpose to get the words W[t] of all messages
+    for(i=0; i<16; i++) W[i] = _mm512_loadu_si512((const void*) blocks[i]);
+    sha256_transpose16x16_avx512f(W);
+
+    // Byte swap by selecting the bytes from both rotations by 8 bits, vpshufb needs AVX512BW
+    for(t=0; t<16; t++) W[t] = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W[t], 8), _mm512_rol_epi32(W[t], 8), MASK, 0xE4);
+
+    for(i=0; i<8; i++) s[i] = state[i];
+    sha256_rounds_x16_avx512f(s, W);
+
+    // Get intermediate hash in the active lanes
+    for(i=0; i<8; i++) state[i] = _mm512_mask_add_epi32(state[i], active, state[i], s[i]);
+}
+
+/* AVX-512: Hash sixteen messages starting from the initial hash iv, one message per lane */
+static inline void
+sha256_hash_x16_avx512f(uint32_t* hash, const uint32_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens){
+    __VOLK_ATTR_ALIGNED(64) uint8_t tail[16][128]; // padding blocks of each message
+    __VOLK_ATTR_ALIGNED(64) int32_t N_total[16]; // number of blocks including padding of each message
+    unsigned int N[16]; // number of full 512 bit blocks of each message
+    const uint8_t* blocks[16];
+    __m512i state[8], N_vec, index;
+    unsigned int i, k, N_max = 0;
+
+    // Pad each message lane-wise
+    for(i=0; i<16; i++){
+        N[i] = msg_lens[i] / 64;
+        N_total[i] = N[i] + sha256_pad_tail(tail[i], msgs[i] + 64*N[i], msg_lens[i] % 64, (uint64_t) msg_lens[i] * 8);
+        if((unsigned int) N_total[i] > N_max) N_max = N_total[i];
+    }
+    for(i=0; i<8; i++) state[i] = _mm512_set1_epi32(iv[i]);
+    N_vec = _mm512_load_si512((const void*) N_total);
+
+    // Run all lanes until the longest message is done, finished lanes process a dummy block and keep their hash
+    for(k=0; k<N_max; k++){
+        for(i=0; i<16; i++){
+            if(k < N[i]) blocks[i] = msgs[i] + 64*k;
+            else if(k < (unsigned int) N_total[i]) blocks[i] = tail[i] + 64*(k - N[i]);
+            else blocks[i] = tail[i];
+        }
+        sha256_process_block_x16_avx512f(state, blocks, _mm512_cmpgt_epi32_mask(N_vec, _mm512_set1_epi32(k)));
+    }
+
+    // Scatter word i of all lanes to the hash of each message
+    index = _mm512_mullo_epi32(_mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), _mm512_set1_epi32(8));
+    for(i=0; i<8; i++) _mm512_i32scatter_epi32((void*) (hash + i), index, state[i], 4);
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+#ifdef LV_HAVE_AVX512F
+
+static inline void
+volk_sha256_8u_x16_hash_32u_avx512f(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_x16_avx512f(hash, H0, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+#endif /* INCLUDED_volk_sha256_8u_x16_hash_32u_a_H */
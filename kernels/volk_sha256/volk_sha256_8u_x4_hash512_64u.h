@@ -0,0 +1,213 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash512_64u.h>
+
+/*
+ * NOTE:
+ * SHA-512 of four independent messages msgs[0..3] with the lengths msg_lens[0..3] in bytes.
+ * The hash of message i is written to hash[8*i] to hash[8*i+7].
+ * The AVX2 implementation runs one message per 64 bit lane of a YMM register, messages of different lengths
+ * are padded lane-wise and lanes which are already finished are masked out.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x4_hash512_64u_a_H
+#define INCLUDED_volk_sha256_8u_x4_hash512_64u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x4_hash512_64u_generic(uint64_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<4; i++) sha512_hash_blocks_iv(hash + 8*i, H0_512, msgs[i], msg_lens[i], sha512_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Operations on four 64 bit words, one per lane */
+#define ROTR64_AVX2(x, n)       _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+#define XOR3_64_AVX2(x, y, z)   _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define CH64_AVX2(x, y, z)      _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
+#define MAJ64_AVX2(x, y, z)     _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(_mm256_or_si256(x, y), z))
+#define EPSILON512_0_AVX2(x)    XOR3_64_AVX2(ROTR64_AVX2(x, 28), ROTR64_AVX2(x, 34), ROTR64_AVX2(x, 39))
+#define EPSILON512_1_AVX2(x)    XOR3_64_AVX2(ROTR64_AVX2(x, 14), ROTR64_AVX2(x, 18), ROTR64_AVX2(x, 41))
+#define SIGMA512_0_AVX2(x)      XOR3_64_AVX2(ROTR64_AVX2(x, 1), ROTR64_AVX2(x, 8), _mm256_srli_epi64(x, 7))
+#define SIGMA512_1_AVX2(x)      XOR3_64_AVX2(ROTR64_AVX2(x, 19), ROTR64_AVX2(x, 61), _mm256_srli_epi64(x, 6))
+
+/* AVX2: Single round in the sha512 main loop on four messages */
+#define SHA512_ROUND_AVX2(a, b, c, d, e, f, g, h, W, k)                                         \
+T1 = _mm256_add_epi64(_mm256_add_epi64(h, EPSILON512_1_AVX2(e)), _mm256_add_epi64(CH64_AVX2(e, f, g), \
+    _mm256_add_epi64(W, _mm256_set1_epi64x((long long) K512[k]))));                             \
+d = _mm256_add_epi64(d, T1);                                                                    \
+T2 = _mm256_add_epi64(EPSILON512_0_AVX2(a), MAJ64_AVX2(a, b, c));                               \
+h = _mm256_add_epi64(T1, T2)
+
+/* AVX2: Calculate W[t] in place of W[t-16] */
+#define SHA512_SCHEDULE_AVX2(W, t)                                                              \
+W[(t)&15] = _mm256_add_epi64(_mm256_add_epi64(SIGMA512_1_AVX2(W[((t)-2)&15]), W[((t)-7)&15]),   \
+    _mm256_add_epi64(SIGMA512_0_AVX2(W[((t)-15)&15]), W[(t)&15]))
+
+/* AVX2: Transpose a 4x4 matrix of 64 bit words, row i becomes lane i */
+static inline void
+sha512_transpose4x4_avx2(__m256i* r){
+    __m256i t0, t1, t2, t3;
+
+    t0 = _mm256_unpacklo_epi64(r[0], r[1]);
+    t1 = _mm256_unpackhi_epi64(r[0], r[1]);
+    t2 = _mm256_unpacklo_epi64(r[2], r[3]);
+    t3 = _mm256_unpackhi_epi64(r[2], r[3]);
+    r[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    r[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    r[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    r[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+/* AVX2: Process one block of 1024 bits of four messages, the hash is only updated in the active lanes */
+static inline void
+sha512_process_block_x4_avx2(__m256i* state, const uint8_t* const* blocks, __m256i active){
+    const __m256i MASK = _mm256_set_epi64x(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+                                           0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL); // byte swap per 64 bit word
+    __m256i W[16], a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int i, t;
+
+    // Load the blocks as rows and transpose to get the words W[t] of all messages
+    for(i=0; i<4; i++){
+        W[i] = _mm256_loadu_si256((const __m256i*) blocks[i]);
+        W[i+4] = _mm256_loadu_si256((const __m256i*) (blocks[i] + 32));
+        W[i+8] = _mm256_loadu_si256((const __m256i*) (blocks[i] + 64));
+        W[i+12] = _mm256_loadu_si256((const __m256i*) (blocks[i] + 96));
+    }
+    for(t=0; t<16; t+=4) sha512_transpose4x4_avx2(W + t);
+    for(t=0; t<16; t++) W[t] = _mm256_shuffle_epi8(W[t], MASK);
+
+    // Init a to h
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
+
+    // First 16 rounds take the message directly
+    for(t=0; t<16; t+=8){
+        SHA512_ROUND_AVX2(a, b, c, d, e, f, g, h, W[t], t);
+        SHA512_ROUND_AVX2(h, a, b, c, d, e, f, g, W[t+1], t+1);
+        SHA512_ROUND_AVX2(g, h, a, b, c, d, e, f, W[t+2], t+2);
+        SHA512_ROUND_AVX2(f, g, h, a, b, c, d, e, W[t+3], t+3);
+        SHA512_ROUND_AVX2(e, f, g, h, a, b, c, d, W[t+4], t+4);
+        SHA512_ROUND_AVX2(d, e, f, g, h, a, b, c, W[t+5], t+5);
+        SHA512_ROUND_AVX2(c, d, e, f, g, h, a, b, W[t+6], t+6);
+        SHA512_ROUND_AVX2(b, c, d, e, f, g, h, a, W[t+7], t+7);
+    }
+
+    // Remaining rounds calculate W on the fly
+    for(t=16; t<80; t+=8){
+        SHA512_SCHEDULE_AVX2(W, t);
+        SHA512_ROUND_AVX2(a, b, c, d, e, f, g, h, W[t&15], t);
+        SHA512_SCHEDULE_AVX2(W, t+1);
+        SHA512_ROUND_AVX2(h, a, b, c, d, e, f, g, W[(t+1)&15], t+1);
+        SHA512_SCHEDULE_AVX2(W, t+2);
+        SHA512_ROUND_AVX2(g, h, a, b, c, d, e, f, W[(t+2)&15], t+2);
+        SHA512_SCHEDULE_AVX2(W, t+3);
+        SHA512_ROUND_AVX2(f, g, h, a, b, c, d, e, W[(t+3)&15], t+3);
+        SHA512_SCHEDULE_AVX2(W, t+4);
+        SHA512_ROUND_AVX2(e, f, g, h, a, b, c, d, W[(t+4)&15], t+4);
+        SHA512_SCHEDULE_AVX2(W, t+5);
+        SHA512_ROUND_AVX2(d, e, f, g, h, a, b, c, W[(t+5)&15], t+5);
+        SHA512_SCHEDULE_AVX2(W, t+6);
+        SHA512_ROUND_AVX2(c, d, e, f, g, h, a, b, W[(t+6)&15], t+6);
+        SHA512_SCHEDULE_AVX2(W, t+7);
+        SHA512_ROUND_AVX2(b, c, d, e, f, g, h, a, W[(t+7)&15], t+7);
+    }
+
+    // Get intermediate hash in the active lanes
+    state[0] = _mm256_blendv_epi8(state[0], _mm256_add_epi64(state[0], a), active);
+    state[1] = _mm256_blendv_epi8(state[1], _mm256_add_epi64(state[1], b), active);
+    state[2] = _mm256_blendv_epi8(state[2], _mm256_add_epi64(state[2], c), active);
+    state[3] = _mm256_blendv_epi8(state[3], _mm256_add_epi64(state[3], d), active);
+    state[4] = _mm256_blendv_epi8(state[4], _mm256_add_epi64(state[4], e), active);
+    state[5] = _mm256_blendv_epi8(state[5], _mm256_add_epi64(state[5], f), active);
+    state[6] = _mm256_blendv_epi8(state[6], _mm256_add_epi64(state[6], g), active);
+    state[7] = _mm256_blendv_epi8(state[7], _mm256_add_epi64(state[7], h), active);
+}
+
+/* AVX2: Hash four messages starting from the initial hash iv, one message per lane */
+static inline void
+sha512_hash_x4_avx2(uint64_t* hash, const uint64_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens){
+    __VOLK_ATTR_ALIGNED(32) uint8_t tail[4][256]; // padding blocks of each message
+    __VOLK_ATTR_ALIGNED(32) int64_t N_total[4]; // number of blocks including padding of each message
+    unsigned int N[4]; // number of full 1024 bit blocks of each message
+    const uint8_t* blocks[4];
+    __m256i state[8], N_vec;
+    unsigned int i, k, N_max = 0;
+
+    // Pad each message lane-wise
+    for(i=0; i<4; i++){
+        N[i] = msg_lens[i] / 128;
+        N_total[i] = N[i] + sha512_pad_tail(tail[i], msgs[i] + 128*N[i], msg_lens[i] % 128, (uint64_t) msg_lens[i] * 8);
+        if((unsigned int) N_total[i] > N_max) N_max = N_total[i];
+    }
+    for(i=0; i<8; i++) state[i] = _mm256_set1_epi64x((long long) iv[i]);
+    N_vec = _mm256_load_si256((const __m256i*) N_total);
+
+    // Run all lanes until the longest message is done, finished lanes process a dummy block and keep their hash
+    for(k=0; k<N_max; k++){
+        for(i=0; i<4; i++){
+            if(k < N[i]) blocks[i] = msgs[i] + 128*k;
+            else if(k < (unsigned int) N_total[i]) blocks[i] = tail[i] + 128*(k - N[i]);
+            else blocks[i] = tail[i];
+        }
+        sha512_process_block_x4_avx2(state, blocks, _mm256_cmpgt_epi64(N_vec, _mm256_set1_epi64x(k)));
+    }
+
+    // Transpose back to one hash per message
+    sha512_transpose4x4_avx2(state);
+    sha512_transpose4x4_avx2(state + 4);
+    for(i=0; i<4; i++){
+        _mm256_storeu_si256((__m256i*) (hash + 8*i), state[i]);
+        _mm256_storeu_si256((__m256i*) (hash + 8*i + 4), state[i+4]);
+    }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_x4_hash512_64u_avx2(uint64_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha512_hash_x4_avx2(hash, H0_512, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_sha256_8u_x4_hash512_64u_a_H */
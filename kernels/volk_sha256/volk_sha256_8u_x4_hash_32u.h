@@ -0,0 +1,300 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes four independent messages msgs[0..3] with the lengths msg_lens[0..3] in bytes.
+ * The hash of message i is written to hash[8*i] to hash[8*i+7].
+ * The SIMD implementations run one message per 32 bit lane, messages of different lengths are
+ * padded lane-wise and lanes which are already finished are masked out.
+ * The generic_ilp4 implementation interleaves the rounds of four messages in plain C, the compiler vectorizes
+ * them where the target has any SIMD unit and overlaps the four dependency chains where it has none.
+ * The SHA-NI implementations interleave the rounds of two or four messages to hide the latency of
+ * sha256rnds2, the profiler picks the interleave factor that suits the CPU.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x4_hash_32u_a_H
+#define INCLUDED_volk_sha256_8u_x4_hash_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x4_hash_32u_generic_ilp4(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_ilp4_generic(hash, H0, msgs, msg_lens, 4);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x4_hash_32u_generic(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<4; i++) sha256_hash_blocks(hash + 8*i, msgs[i], msg_lens[i], sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+/* SSE: Further operations on four words, one per lane */
+#define XOR3_SSE(x, y, z)       _mm_xor_si128(_mm_xor_si128(x, y), z)
+#define CH_SSE(x, y, z)         _mm_xor_si128(_mm_and_si128(x, y), _mm_andnot_si128(x, z))
+#define MAJ_SSE(x, y, z)        _mm_or_si128(_mm_and_si128(x, y), _mm_and_si128(_mm_or_si128(x, y), z))
+#define EPSILON_0_SSE(x)        XOR3_SSE(ROTR_SSE(x, 2), ROTR_SSE(x, 13), ROTR_SSE(x, 22))
+#define EPSILON_1_SSE(x)        XOR3_SSE(ROTR_SSE(x, 6), ROTR_SSE(x, 11), ROTR_SSE(x, 25))
+
+/* SSE: Single round in the sha256 main loop on four messages */
+#define SHA256_ROUND_SSE(a, b, c, d, e, f, g, h, W, k)                                          \
+T1 = _mm_add_epi32(_mm_add_epi32(h, EPSILON_1_SSE(e)), _mm_add_epi32(CH_SSE(e, f, g),            \
+    _mm_add_epi32(W, _mm_set1_epi32(K[k]))));                                                   \
+d = _mm_add_epi32(d, T1);                                                                       \
+T2 = _mm_add_epi32(EPSILON_0_SSE(a), MAJ_SSE(a, b, c));                                         \
+h = _mm_add_epi32(T1, T2)
+
+/* SSE: Calculate W[t] in place of W[t-16] */
+#define SHA256_SCHEDULE_SSE(W, t)                                                               \
+W[(t)&15] = _mm_add_epi32(_mm_add_epi32(SIGMA_1_SSE(W[((t)-2)&15]), W[((t)-7)&15]),             \
+    _mm_add_epi32(SIGMA_0_SSE(W[((t)-15)&15]), W[(t)&15]))
+
+/* SSE: Function processing one block of 512 bits of four messages, the hash is only updated in the active lanes */
+typedef void (*sha256_block_x4_func_t)(__m128i* state, const uint8_t* const* blocks, __m128i active);
+
+/* SSE: Transpose a 4x4 matrix of words, row i becomes lane i */
+static inline void
+sha256_transpose4x4_sse2(__m128i* r){
+    __m128i t0, t1, t2, t3;
+
+    t0 = _mm_unpacklo_epi32(r[0], r[1]);
+    t1 = _mm_unpacklo_epi32(r[2], r[3]);
+    t2 = _mm_unpackhi_epi32(r[0], r[1]);
+    t3 = _mm_unpackhi_epi32(r[2], r[3]);
+
+    r[0] = _mm_unpacklo_epi64(t0, t1);
+    r[1] = _mm_unpackhi_epi64(t0, t1);
+    r[2] = _mm_unpacklo_epi64(t2, t3);
+    r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/* SSE: Load one block of four messages as rows and transpose to get the words W[t] of all messages */
+static inline void
+sha256_load_block_x4_sse2(__m128i* W, const uint8_t* const* blocks){
+    unsigned int i, j;
+
+    for(i=0; i<4; i++){
+        for(j=0; j<4; j++) W[4*j+i] = _mm_loadu_si128((const __m128i*) (blocks[i] + 16*j));
+    }
+    for(j=0; j<4; j++) sha256_transpose4x4_sse2(W + 4*j);
+}
+
+/* SSE: Run the 64 rounds of the sha256 main loop on four messages, s holds a to h */
+static inline void
+sha256_rounds_x4_sse2(__m128i* s, __m128i* W){
+    __m128i a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int t;
+
+    a = s[0];
+    b = s[1];
+    c = s[2];
+    d = s[3];
+    e = s[4];
+    f = s[5];
+    g = s[6];
+    h = s[7];
+
+    // First 16 rounds take the message directly
+    for(t=0; t<16; t+=8){
+        SHA256_ROUND_SSE(a, b, c, d, e, f, g, h, W[t], t);
+        SHA256_ROUND_SSE(h, a, b, c, d, e, f, g, W[t+1], t+1);
+        SHA256_ROUND_SSE(g, h, a, b, c, d, e, f, W[t+2], t+2);
+        SHA256_ROUND_SSE(f, g, h, a, b, c, d, e, W[t+3], t+3);
+        SHA256_ROUND_SSE(e, f, g, h, a, b, c, d, W[t+4], t+4);
+        SHA256_ROUND_SSE(d, e, f, g, h, a, b, c, W[t+5], t+5);
+        SHA256_ROUND_SSE(c, d, e, f, g, h, a, b, W[t+6], t+6);
+        SHA256_ROUND_SSE(b, c, d, e, f, g, h, a, W[t+7], t+7);
+    }
+
+    // Remaining rounds calculate W on the fly
+    for(t=16; t<64; t+=8){
+        SHA256_SCHEDULE_SSE(W, t);
+        SHA256_ROUND_SSE(a, b, c, d, e, f, g, h, W[t&15], t);
+        SHA256_SCHEDULE_SSE(W, t+1);
+        SHA256_ROUND_SSE(h, a, b, c, d, e, f, g, W[(t+1)&15], t+1);
+        SHA256_SCHEDULE_SSE(W, t+2);
+        SHA256_ROUND_SSE(g, h, a, b, c, d, e, f, W[(t+2)&15], t+2);
+        SHA256_SCHEDULE_SSE(W, t+3);
+        SHA256_ROUND_SSE(f, g, h, a, b, c, d, e, W[(t+3)&15], t+3);
+        SHA256_SCHEDULE_SSE(W, t+4);
+        SHA256_ROUND_SSE(e, f, g, h, a, b, c, d, W[(t+4)&15], t+4);
+        SHA256_SCHEDULE_SSE(W, t+5);
+        SHA256_ROUND_SSE(d, e, f, g, h, a, b, c, W[(t+5)&15], t+5);
+        SHA256_SCHEDULE_SSE(W, t+6);
+        SHA256_ROUND_SSE(c, d, e, f, g, h, a, b, W[(t+6)&15], t+6);
+        SHA256_SCHEDULE_SSE(W, t+7);
+        SHA256_ROUND_SSE(b, c, d, e, f, g, h, a, W[(t+7)&15], t+7);
+    }
+
+    s[0] = a;
+    s[1] = b;
+    s[2] = c;
+    s[3] = d;
+    s[4] = e;
+    s[5] = f;
+    s[6] = g;
+    s[7] = h;
+}
+
+/* SSE2: Process one block of 512 bits of four messages, byte swap with shifts and mask with logic operations */
+static inline void
+sha256_process_block_x4_sse2(__m128i* state, const uint8_t* const* blocks, __m128i active){
+    const __m128i MASK = _mm_set1_epi32(0x00ff00ff);
+    __m128i W[16], s[8];
+    unsigned int i;
+
+    sha256_load_block_x4_sse2(W, blocks);
+    for(i=0; i<16; i++){
+        W[i] = _mm_shufflehi_epi16(_mm_shufflelo_epi16(W[i], 0xB1), 0xB1); // swap half words
+        W[i] = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(W[i], 8), MASK), _mm_slli_epi16(_mm_and_si128(W[i], MASK), 8)); // swap bytes
+    }
+
+    for(i=0; i<8; i++) s[i] = state[i];
+    sha256_rounds_x4_sse2(s, W);
+
+    // Get intermediate hash in the active lanes
+    for(i=0; i<8; i++){
+        state[i] = _mm_or_si128(_mm_and_si128(active, _mm_add_epi32(state[i], s[i])), _mm_andnot_si128(active, state[i]));
+    }
+}
+
+/* SSE: Hash four messages starting from the initial hash iv with a function processing one block of each message */
+static inline void
+sha256_hash_x4_sse2(uint32_t* hash, const uint32_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens,
+                    sha256_block_x4_func_t process_block){
+    __VOLK_ATTR_ALIGNED(16) uint8_t tail[4][128]; // padding blocks of each message
+    __VOLK_ATTR_ALIGNED(16) int32_t N_total[4]; // number of blocks including padding of each message
+    unsigned int N[4]; // number of full 512 bit blocks of each message
+    const uint8_t* blocks[4];
+    __m128i state[8], N_vec;
+    unsigned int i, k, N_max = 0;
+
+    // Pad each message lane-wise
+    for(i=0; i<4; i++){
+        N[i] = msg_lens[i] / 64;
+        N_total[i] = N[i] + sha256_pad_tail(tail[i], msgs[i] + 64*N[i], msg_lens[i] % 64, (uint64_t) msg_lens[i] * 8);
+        if((unsigned int) N_total[i] > N_max) N_max = N_total[i];
+    }
+    for(i=0; i<8; i++) state[i] = _mm_set1_epi32(iv[i]);
+    N_vec = _mm_load_si128((const __m128i*) N_total);
+
+    // Run all lanes until the longest message is done, finished lanes process a dummy block and keep their hash
+    for(k=0; k<N_max; k++){
+        for(i=0; i<4; i++){
+            if(k < N[i]) blocks[i] = msgs[i] + 64*k;
+            else if(k < (unsigned int) N_total[i]) blocks[i] = tail[i] + 64*(k - N[i]);
+            else blocks[i] = tail[i];
+        }
+        process_block(state, blocks, _mm_cmpgt_epi32(N_vec, _mm_set1_epi32(k)));
+    }
+
+    // Transpose back to one hash per message
+    sha256_transpose4x4_sse2(state);
+    sha256_transpose4x4_sse2(state + 4);
+    for(i=0; i<4; i++){
+        _mm_storeu_si128((__m128i*) (hash + 8*i), state[i]);
+        _mm_storeu_si128((__m128i*) (hash + 8*i + 4), state[i+4]);
+    }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#ifdef LV_HAVE_SSE2
+
+static inline void
+volk_sha256_8u_x4_hash_32u_sse2(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_x4_sse2(hash, H0, msgs, msg_lens, sha256_process_block_x4_sse2);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+/* SSE4.1: Process one block of 512 bits of four messages, byte swap with pshufb and mask with blendv */
+static inline void
+sha256_process_block_x4_sse4_1(__m128i* state, const uint8_t* const* blocks, __m128i active){
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    __m128i W[16], s[8];
+    unsigned int i;
+
+    sha256_load_block_x4_sse2(W, blocks);
+    for(i=0; i<16; i++) W[i] = _mm_shuffle_epi8(W[i], MASK);
+
+    for(i=0; i<8; i++) s[i] = state[i];
+    sha256_rounds_x4_sse2(s, W);
+
+    // Get intermediate hash in the active lanes
+    for(i=0; i<8; i++) state[i] = _mm_blendv_epi8(state[i], _mm_add_epi32(state[i], s[i]), active);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x4_hash_32u_sse4_1(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_x4_sse2(hash, H0, msgs, msg_lens, sha256_process_block_x4_sse4_1);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x4_hash_32u_shani_2way(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_ways_shani(hash, H0, msgs, msg_lens, 4, 2);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x4_hash_32u_shani_4way(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_ways_shani(hash, H0, msgs, msg_lens, 4, 4);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_x4_hash_32u_a_H */
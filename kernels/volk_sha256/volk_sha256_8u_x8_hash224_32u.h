@@ -0,0 +1,125 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256_8u_hash224_32u.h>
+#include <volk_sha256/volk_sha256_8u_x4_hash_32u.h>
+#include <volk_sha256/volk_sha256_8u_x8_hash_32u.h>
+
+/*
+ * NOTE:
+ * SHA-224 of eight independent messages msgs[0..7] with the lengths msg_lens[0..7] in bytes.
+ * The hash of message i is written to hash[7*i] to hash[7*i+6].
+ * The implementations run the multi-buffer code of volk_sha256_8u_x4_hash_32u and volk_sha256_8u_x8_hash_32u
+ * from the SHA-224 initial hash and truncate the states. The SSE implementations run two groups of four lanes.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x8_hash224_32u_a_H
+#define INCLUDED_volk_sha256_8u_x8_hash224_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_generic_ilp4(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    uint32_t state[64]; // full states of all messages
+    sha256_hash_ilp4_generic(state, H0_224, msgs, msg_lens, 8);
+    sha224_truncate_hashes(hash, state, 8);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_generic(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<8; i++) sha224_hash_blocks(hash + 7*i, msgs[i], msg_lens[i], sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE2
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_sse2(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    uint32_t state[64]; // full states of all messages
+    sha256_hash_x4_sse2(state, H0_224, msgs, msg_lens, sha256_process_block_x4_sse2);
+    sha256_hash_x4_sse2(state + 32, H0_224, msgs + 4, msg_lens + 4, sha256_process_block_x4_sse2);
+    sha224_truncate_hashes(hash, state, 8);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#ifdef LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_sse4_1(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    uint32_t state[64]; // full states of all messages
+    sha256_hash_x4_sse2(state, H0_224, msgs, msg_lens, sha256_process_block_x4_sse4_1);
+    sha256_hash_x4_sse2(state + 32, H0_224, msgs + 4, msg_lens + 4, sha256_process_block_x4_sse4_1);
+    sha224_truncate_hashes(hash, state, 8);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_avx2(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    uint32_t state[64]; // full states of all messages
+    sha256_hash_x8_avx2(state, H0_224, msgs, msg_lens);
+    sha224_truncate_hashes(hash, state, 8);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_shani_2way(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    uint32_t state[64]; // full states of all messages
+    sha256_hash_ways_shani(state, H0_224, msgs, msg_lens, 8, 2);
+    sha224_truncate_hashes(hash, state, 8);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x8_hash224_32u_shani_4way(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    uint32_t state[64]; // full states of all messages
+    sha256_hash_ways_shani(state, H0_224, msgs, msg_lens, 8, 4);
+    sha224_truncate_hashes(hash, state, 8);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_x8_hash224_32u_a_H */
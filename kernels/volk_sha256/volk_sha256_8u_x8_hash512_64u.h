@@ -0,0 +1,234 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash512_64u.h>
+#include <volk_sha256/volk_sha256_8u_x4_hash512_64u.h>
+
+/*
+ * NOTE:
+ * SHA-512 of eight independent messages msgs[0..7] with the lengths msg_lens[0..7] in bytes.
+ * The hash of message i is written to hash[8*i] to hash[8*i+7].
+ * The AVX-512 implementation runs one message per 64 bit lane of a ZMM register, the AVX2 implementation
+ * runs the 4-lane kernel twice and is kept as reference for the profiler.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x8_hash512_64u_a_H
+#define INCLUDED_volk_sha256_8u_x8_hash512_64u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x8_hash512_64u_generic(uint64_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<8; i++) sha512_hash_blocks_iv(hash + 8*i, H0_512, msgs[i], msg_lens[i], sha512_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_x8_hash512_64u_avx2(uint64_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha512_hash_x4_avx2(hash, H0_512, msgs, msg_lens);
+    sha512_hash_x4_avx2(hash + 32, H0_512, msgs + 4, msg_lens + 4);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+
+/* AVX-512: Operations on eight 64 bit words, one per lane, with vprorq and vpternlogq */
+#define XOR3_64_AVX512(x, y, z) _mm512_ternarylogic_epi64(x, y, z, 0x96)
+#define CH64_AVX512(x, y, z)    _mm512_ternarylogic_epi64(x, y, z, 0xCA)
+#define MAJ64_AVX512(x, y, z)   _mm512_ternarylogic_epi64(x, y, z, 0xE8)
+#define EPSILON512_0_AVX512(x)  XOR3_64_AVX512(_mm512_ror_epi64(x, 28), _mm512_ror_epi64(x, 34), _mm512_ror_epi64(x, 39))
+#define EPSILON512_1_AVX512(x)  XOR3_64_AVX512(_mm512_ror_epi64(x, 14), _mm512_ror_epi64(x, 18), _mm512_ror_epi64(x, 41))
+#define SIGMA512_0_AVX512(x)    XOR3_64_AVX512(_mm512_ror_epi64(x, 1), _mm512_ror_epi64(x, 8), _mm512_srli_epi64(x, 7))
+#define SIGMA512_1_AVX512(x)    XOR3_64_AVX512(_mm512_ror_epi64(x, 19), _mm512_ror_epi64(x, 61), _mm512_srli_epi64(x, 6))
+
+/* AVX-512: Single round in the sha512 main loop on eight messages */
+#define SHA512_ROUND_AVX512(a, b, c, d, e, f, g, h, W, k)                                       \
+T1 = _mm512_add_epi64(_mm512_add_epi64(h, EPSILON512_1_AVX512(e)), _mm512_add_epi64(CH64_AVX512(e, f, g), \
+    _mm512_add_epi64(W, _mm512_set1_epi64((long long) K512[k]))));                              \
+d = _mm512_add_epi64(d, T1);                                                                    \
+T2 = _mm512_add_epi64(EPSILON512_0_AVX512(a), MAJ64_AVX512(a, b, c));                           \
+h = _mm512_add_epi64(T1, T2)
+
+/* AVX-512: Calculate W[t] in place of W[t-16] */
+#define SHA512_SCHEDULE_AVX512(W, t)                                                            \
+W[(t)&15] = _mm512_add_epi64(_mm512_add_epi64(SIGMA512_1_AVX512(W[((t)-2)&15]), W[((t)-7)&15]), \
+    _mm512_add_epi64(SIGMA512_0_AVX512(W[((t)-15)&15]), W[(t)&15]))
+
+/* AVX-512: Transpose a 8x8 matrix of 64 bit words, row i becomes lane i */
+static inline void
+sha512_transpose8x8_avx512f(__m512i* r){
+    __m512i t[8], AB, CD;
+    unsigned int i, j;
+
+    // Interleave words, chunk L of t[2*i+j] holds word 2*L+j of the rows 2*i and 2*i+1
+    for(i=0; i<8; i+=2){
+        t[i] = _mm512_unpacklo_epi64(r[i], r[i+1]);
+        t[i+1] = _mm512_unpackhi_epi64(r[i], r[i+1]);
+    }
+
+    // Gather the 128 bit chunks
+    for(j=0; j<2; j++){
+        AB = _mm512_shuffle_i64x2(t[j], t[2+j], 0x44);
+        CD = _mm512_shuffle_i64x2(t[4+j], t[6+j], 0x44);
+        r[j] = _mm512_shuffle_i64x2(AB, CD, 0x88);
+        r[2+j] = _mm512_shuffle_i64x2(AB, CD, 0xDD);
+        AB = _mm512_shuffle_i64x2(t[j], t[2+j], 0xEE);
+        CD = _mm512_shuffle_i64x2(t[4+j], t[6+j], 0xEE);
+        r[4+j] = _mm512_shuffle_i64x2(AB, CD, 0x88);
+        r[6+j] = _mm512_shuffle_i64x2(AB, CD, 0xDD);
+    }
+}
+
+/* AVX-512: Process one block of 1024 bits of eight messages, the hash is only updated in the active lanes */
+static inline void
+sha512_process_block_x8_avx512f(__m512i* state, const uint8_t* const* blocks, __mmask8 active){
+    const __m512i MASK = _mm512_set1_epi32(0xff00ff00);
+    __m512i W[16], a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int i, t;
+
+    // Load the blocks as rows and transpose to get the words W[t] of all messages
+    for(i=0; i<8; i++){
+        W[i] = _mm512_loadu_si512((const void*) blocks[i]);
+        W[i+8] = _mm512_loadu_si512((const void*) (blocks[i] + 64));
+    }
+    sha512_transpose8x8_avx512f(W);
+    sha512_transpose8x8_avx512f(W + 8);
+
+    // Byte swap the 32 bit halves by selecting the bytes from both rotations by 8 bits and swap the halves,
+    // vpshufb needs AVX512BW
+    for(t=0; t<16; t++){
+        W[t] = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W[t], 8), _mm512_rol_epi32(W[t], 8), MASK, 0xE4);
+        W[t] = _mm512_ror_epi64(W[t], 32);
+    }
+
+    // Init a to h
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
+
+    // First 16 rounds take the message directly
+    for(t=0; t<16; t+=8){
+        SHA512_ROUND_AVX512(a, b, c, d, e, f, g, h, W[t], t);
+        SHA512_ROUND_AVX512(h, a, b, c, d, e, f, g, W[t+1], t+1);
+        SHA512_ROUND_AVX512(g, h, a, b, c, d, e, f, W[t+2], t+2);
+        SHA512_ROUND_AVX512(f, g, h, a, b, c, d, e, W[t+3], t+3);
+        SHA512_ROUND_AVX512(e, f, g, h, a, b, c, d, W[t+4], t+4);
+        SHA512_ROUND_AVX512(d, e, f, g, h, a, b, c, W[t+5], t+5);
+        SHA512_ROUND_AVX512(c, d, e, f, g, h, a, b, W[t+6], t+6);
+        SHA512_ROUND_AVX512(b, c, d, e, f, g, h, a, W[t+7], t+7);
+    }
+
+    // Remaining rounds calculate W on the fly
+    for(t=16; t<80; t+=8){
+        SHA512_SCHEDULE_AVX512(W, t);
+        SHA512_ROUND_AVX512(a, b, c, d, e, f, g, h, W[t&15], t);
+        SHA512_SCHEDULE_AVX512(W, t+1);
+        SHA512_ROUND_AVX512(h, a, b, c, d, e, f, g, W[(t+1)&15], t+1);
+        SHA512_SCHEDULE_AVX512(W, t+2);
+        SHA512_ROUND_AVX512(g, h, a, b, c, d, e, f, W[(t+2)&15], t+2);
+        SHA512_SCHEDULE_AVX512(W, t+3);
+        SHA512_ROUND_AVX512(f, g, h, a, b, c, d, e, W[(t+3)&15], t+3);
+        SHA512_SCHEDULE_AVX512(W, t+4);
+        SHA512_ROUND_AVX512(e, f, g, h, a, b, c, d, W[(t+4)&15], t+4);
+        SHA512_SCHEDULE_AVX512(W, t+5);
+        SHA512_ROUND_AVX512(d, e, f, g, h, a, b, c, W[(t+5)&15], t+5);
+        SHA512_SCHEDULE_AVX512(W, t+6);
+        SHA512_ROUND_AVX512(c, d, e, f, g, h, a, b, W[(t+6)&15], t+6);
+        SHA512_SCHEDULE_AVX512(W, t+7);
+        SHA512_ROUND_AVX512(b, c, d, e, f, g, h, a, W[(t+7)&15], t+7);
+    }
+
+    // Get intermediate hash in the active lanes
+    state[0] = _mm512_mask_add_epi64(state[0], active, state[0], a);
+    state[1] = _mm512_mask_add_epi64(state[1], active, state[1], b);
+    state[2] = _mm512_mask_add_epi64(state[2], active, state[2], c);
+    state[3] = _mm512_mask_add_epi64(state[3], active, state[3], d);
+    state[4] = _mm512_mask_add_epi64(state[4], active, state[4], e);
+    state[5] = _mm512_mask_add_epi64(state[5], active, state[5], f);
+    state[6] = _mm512_mask_add_epi64(state[6], active, state[6], g);
+    state[7] = _mm512_mask_add_epi64(state[7], active, state[7], h);
+}
+
+/* AVX-512: Hash eight messages starting from the initial hash iv, one message per lane */
+static inline void
+sha512_hash_x8_avx512f(uint64_t* hash, const uint64_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens){
+    __VOLK_ATTR_ALIGNED(64) uint8_t tail[8][256]; // padding blocks of each message
+    __VOLK_ATTR_ALIGNED(64) int64_t N_total[8]; // number of blocks including padding of each message
+    unsigned int N[8]; // number of full 1024 bit blocks of each message
+    const uint8_t* blocks[8];
+    __m512i state[8], N_vec;
+    unsigned int i, k, N_max = 0;
+
+    // Pad each message lane-wise
+    for(i=0; i<8; i++){
+        N[i] = msg_lens[i] / 128;
+        N_total[i] = N[i] + sha512_pad_tail(tail[i], msgs[i] + 128*N[i], msg_lens[i] % 128, (uint64_t) msg_lens[i] * 8);
+        if((unsigned int) N_total[i] > N_max) N_max = N_total[i];
+        state[i] = _mm512_set1_epi64((long long) iv[i]);
+    }
+    N_vec = _mm512_load_si512((const void*) N_total);
+
+    // Run all lanes until the longest message is done, finished lanes process a dummy block and keep their hash
+    for(k=0; k<N_max; k++){
+        for(i=0; i<8; i++){
+            if(k < N[i]) blocks[i] = msgs[i] + 128*k;
+            else if(k < (unsigned int) N_total[i]) blocks[i] = tail[i] + 128*(k - N[i]);
+            else blocks[i] = tail[i];
+        }
+        sha512_process_block_x8_avx512f(state, blocks, _mm512_cmpgt_epi64_mask(N_vec, _mm512_set1_epi64(k)));
+    }
+
+    // Transpose back to one hash per message
+    sha512_transpose8x8_avx512f(state);
+    for(i=0; i<8; i++) _mm512_storeu_si512((void*) (hash + 8*i), state[i]);
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+#ifdef LV_HAVE_AVX512F
+
+static inline void
+volk_sha256_8u_x8_hash512_64u_avx512f(uint64_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha512_hash_x8_avx512f(hash, H0_512, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+#endif /* INCLUDED_volk_sha256_8u_x8_hash512_64u_a_H */
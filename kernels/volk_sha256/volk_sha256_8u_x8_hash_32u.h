@@ -0,0 +1,299 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+
+/*
+ * NOTE:
+ * Hashes eight independent messages msgs[0..7] with the lengths msg_lens[0..7] in bytes.
+ * The hash of message i is written to hash[8*i] to hash[8*i+7].
+ * The SIMD implementations run one message per 32 bit lane, messages of different lengths are
+ * padded lane-wise and lanes which are already finished are masked out.
+ * The generic_ilp4 implementation interleaves the rounds of four messages in plain C, the compiler vectorizes
+ * them where the target has any SIMD unit and overlaps the four dependency chains where it has none.
+ * The SHA-NI implementations interleave the rounds of two or four messages to hide the latency of
+ * sha256rnds2, the profiler picks the interleave factor that suits the CPU.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x8_hash_32u_a_H
+#define INCLUDED_volk_sha256_8u_x8_hash_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x8_hash_32u_generic_ilp4(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_ilp4_generic(hash, H0, msgs, msg_lens, 8);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x8_hash_32u_generic(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<8; i++) sha256_hash_blocks(hash + 8*i, msgs[i], msg_lens[i], sha256_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Further operations on eight words, one per lane */
+#define CH_AVX2(x, y, z)        _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
+#define MAJ_AVX2(x, y, z)       _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(_mm256_or_si256(x, y), z))
+#define EPSILON_0_AVX2(x)       XOR3_AVX2(ROTR_AVX2(x, 2), ROTR_AVX2(x, 13), ROTR_AVX2(x, 22))
+#define EPSILON_1_AVX2(x)       XOR3_AVX2(ROTR_AVX2(x, 6), ROTR_AVX2(x, 11), ROTR_AVX2(x, 25))
+
+/* AVX2: Single round in the sha256 main loop on eight messages */
+#define SHA256_ROUND_AVX2(a, b, c, d, e, f, g, h, W, k)                                         \
+T1 = _mm256_add_epi32(_mm256_add_epi32(h, EPSILON_1_AVX2(e)), _mm256_add_epi32(CH_AVX2(e, f, g), \
+    _mm256_add_epi32(W, _mm256_set1_epi32(K[k]))));                                             \
+d = _mm256_add_epi32(d, T1);                                                                    \
+T2 = _mm256_add_epi32(EPSILON_0_AVX2(a), MAJ_AVX2(a, b, c));                                    \
+h = _mm256_add_epi32(T1, T2)
+
+/* AVX2: Calculate W[t] in place of W[t-16] */
+#define SHA256_SCHEDULE_AVX2(W, t)                                                              \
+W[(t)&15] = _mm256_add_epi32(_mm256_add_epi32(SIGMA_1_AVX2(W[((t)-2)&15]), W[((t)-7)&15]),      \
+    _mm256_add_epi32(SIGMA_0_AVX2(W[((t)-15)&15]), W[(t)&15]))
+
+/* AVX2: Transpose a 8x8 matrix of words, row i becomes lane i */
+static inline void
+sha256_transpose8x8_avx2(__m256i* r){
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    r[0] = _mm256_unpacklo_epi64(t0, t2);
+    r[1] = _mm256_unpackhi_epi64(t0, t2);
+    r[2] = _mm256_unpacklo_epi64(t1, t3);
+    r[3] = _mm256_unpackhi_epi64(t1, t3);
+    r[4] = _mm256_unpacklo_epi64(t4, t6);
+    r[5] = _mm256_unpackhi_epi64(t4, t6);
+    r[6] = _mm256_unpacklo_epi64(t5, t7);
+    r[7] = _mm256_unpackhi_epi64(t5, t7);
+
+    t0 = _mm256_permute2x128_si256(r[0], r[4], 0x20);
+    t1 = _mm256_permute2x128_si256(r[1], r[5], 0x20);
+    t2 = _mm256_permute2x128_si256(r[2], r[6], 0x20);
+    t3 = _mm256_permute2x128_si256(r[3], r[7], 0x20);
+    t4 = _mm256_permute2x128_si256(r[0], r[4], 0x31);
+    t5 = _mm256_permute2x128_si256(r[1], r[5], 0x31);
+    t6 = _mm256_permute2x128_si256(r[2], r[6], 0x31);
+    t7 = _mm256_permute2x128_si256(r[3], r[7], 0x31);
+
+    r[0] = t0;
+    r[1] = t1;
+    r[2] = t2;
+    r[3] = t3;
+    r[4] = t4;
+    r[5] = t5;
+    r[6] = t6;
+    r[7] = t7;
+}
+
+/* AVX2: Run the 64 rounds of the sha256 main loop on eight messages, s holds a to h */
+static inline void
+sha256_rounds_x8_avx2(__m256i* s, __m256i* W){
+    __m256i a, b, c, d, e, f, g, h, T1, T2;
+    unsigned int t;
+
+    a = s[0];
+    b = s[1];
+    c = s[2];
+    d = s[3];
+    e = s[4];
+    f = s[5];
+    g = s[6];
+    h = s[7];
+
+    // First 16 rounds take the message directly
+    for(t=0; t<16; t+=8){
+        SHA256_ROUND_AVX2(a, b, c, d, e, f, g, h, W[t], t);
+        SHA256_ROUND_AVX2(h, a, b, c, d, e, f, g, W[t+1], t+1);
+        SHA256_ROUND_AVX2(g, h, a, b, c, d, e, f, W[t+2], t+2);
+        SHA256_ROUND_AVX2(f, g, h, a, b, c, d, e, W[t+3], t+3);
+        SHA256_ROUND_AVX2(e, f, g, h, a, b, c, d, W[t+4], t+4);
+        SHA256_ROUND_AVX2(d, e, f, g, h, a, b, c, W[t+5], t+5);
+        SHA256_ROUND_AVX2(c, d, e, f, g, h, a, b, W[t+6], t+6);
+        SHA256_ROUND_AVX2(b, c, d, e, f, g, h, a, W[t+7], t+7);
+    }
+
+    // Remaining rounds calculate W on the fly
+    for(t=16; t<64; t+=8){
+        SHA256_SCHEDULE_AVX2(W, t);
+        SHA256_ROUND_AVX2(a, b, c, d, e, f, g, h, W[t&15], t);
+        SHA256_SCHEDULE_AVX2(W, t+1);
+        SHA256_ROUND_AVX2(h, a, b, c, d, e, f, g, W[(t+1)&15], t+1);
+        SHA256_SCHEDULE_AVX2(W, t+2);
+        SHA256_ROUND_AVX2(g, h, a, b, c, d, e, f, W[(t+2)&15], t+2);
+        SHA256_SCHEDULE_AVX2(W, t+3);
+        SHA256_ROUND_AVX2(f, g, h, a, b, c, d, e, W[(t+3)&15], t+3);
+        SHA256_SCHEDULE_AVX2(W, t+4);
+        SHA256_ROUND_AVX2(e, f, g, h, a, b, c, d, W[(t+4)&15], t+4);
+        SHA256_SCHEDULE_AVX2(W, t+5);
+        SHA256_ROUND_AVX2(d, e, f, g, h, a, b, c, W[(t+5)&15], t+5);
+        SHA256_SCHEDULE_AVX2(W, t+6);
+        SHA256_ROUND_AVX2(c, d, e, f, g, h, a, b, W[(t+6)&15], t+6);
+        SHA256_SCHEDULE_AVX2(W, t+7);
+        SHA256_ROUND_AVX2(b, c, d, e, f, g, h, a, W[(t+7)&15], t+7);
+    }
+
+    s[0] = a;
+    s[1] = b;
+    s[2] = c;
+    s[3] = d;
+    s[4] = e;
+    s[5] = f;
+    s[6] = g;
+    s[7] = h;
+}
+
+/* AVX2: Load one block of 512 bits of eight messages, W[t] holds the big endian word t of all messages */
+static inline void
+sha256_load_blocks_x8_avx2(__m256i* W, const uint8_t* const* blocks){
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                           0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // byte swap per word
+    unsigned int i, t;
+
+    // Load the blocks as rows and transpose to get the words W[t] of all messages
+    for(i=0; i<8; i++){
+        W[i] = _mm256_loadu_si256((const __m256i*) blocks[i]);
+        W[i+8] = _mm256_loadu_si256((const __m256i*) (blocks[i] + 32));
+    }
+    sha256_transpose8x8_avx2(W);
+    sha256_transpose8x8_avx2(W + 8);
+    for(t=0; t<16; t++) W[t] = _mm256_shuffle_epi8(W[t], MASK);
+}
+
+/* AVX2: Process one block of 512 bits of eight messages, the hash is only updated in the active lanes */
+static inline void
+sha256_process_block_x8_avx2(__m256i* state, const uint8_t* const* blocks, __m256i active){
+    __m256i W[16], s[8];
+    unsigned int i;
+
+    sha256_load_blocks_x8_avx2(W, blocks);
+
+    for(i=0; i<8; i++) s[i] = state[i];
+    sha256_rounds_x8_avx2(s, W);
+
+    // Get intermediate hash in the active lanes
+    for(i=0; i<8; i++) state[i] = _mm256_blendv_epi8(state[i], _mm256_add_epi32(state[i], s[i]), active);
+}
+
+/* AVX2: Function processing one block of 512 bits of eight messages, the hash is only updated in the active lanes */
+typedef void (*sha256_block_x8_func_t)(__m256i* state, const uint8_t* const* blocks, __m256i active);
+
+/* AVX2: Run eight messages through a block function, one message per lane. The messages are padded lane-wise,
+ * state holds the initial hash on entry, which already covers prefix_len bytes (a multiple of 64) before each
+ * message, and the final hash on exit */
+static inline void
+sha256_run_lanes_x8_avx2(__m256i* state, const uint8_t* const* msgs, const unsigned int* msg_lens, uint64_t prefix_len,
+                         sha256_block_x8_func_t process_block){
+    __VOLK_ATTR_ALIGNED(32) uint8_t tail[8][128]; // padding blocks of each message
+    __VOLK_ATTR_ALIGNED(32) int32_t N_total[8]; // number of blocks including padding of each message
+    unsigned int N[8]; // number of full 512 bit blocks of each message
+    const uint8_t* blocks[8];
+    __m256i N_vec;
+    unsigned int i, k, N_max = 0;
+
+    // Pad each message lane-wise
+    for(i=0; i<8; i++){
+        N[i] = msg_lens[i] / 64;
+        N_total[i] = N[i] + sha256_pad_tail(tail[i], msgs[i] + 64*N[i], msg_lens[i] % 64, (prefix_len + msg_lens[i]) * 8);
+        if((unsigned int) N_total[i] > N_max) N_max = N_total[i];
+    }
+    N_vec = _mm256_load_si256((const __m256i*) N_total);
+
+    // Run all lanes until the longest message is done, finished lanes process a dummy block and keep their hash
+    for(k=0; k<N_max; k++){
+        for(i=0; i<8; i++){
+            if(k < N[i]) blocks[i] = msgs[i] + 64*k;
+            else if(k < (unsigned int) N_total[i]) blocks[i] = tail[i] + 64*(k - N[i]);
+            else blocks[i] = tail[i];
+        }
+        process_block(state, blocks, _mm256_cmpgt_epi32(N_vec, _mm256_set1_epi32(k)));
+    }
+}
+
+/* AVX2: Hash eight messages starting from the initial hash iv, one message per lane */
+static inline void
+sha256_hash_x8_avx2(uint32_t* hash, const uint32_t* iv, const uint8_t* const* msgs, const unsigned int* msg_lens){
+    __m256i state[8];
+    unsigned int i;
+
+    for(i=0; i<8; i++) state[i] = _mm256_set1_epi32(iv[i]);
+    sha256_run_lanes_x8_avx2(state, msgs, msg_lens, 0, sha256_process_block_x8_avx2);
+
+    // Transpose back to one hash per message
+    sha256_transpose8x8_avx2(state);
+    for(i=0; i<8; i++) _mm256_storeu_si256((__m256i*) (hash + 8*i), state[i]);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_x8_hash_32u_avx2(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_x8_avx2(hash, H0, msgs, msg_lens);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x8_hash_32u_shani_2way(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_ways_shani(hash, H0, msgs, msg_lens, 8, 2);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#if LV_HAVE_SHA && LV_HAVE_SSE4_1
+
+static inline void
+volk_sha256_8u_x8_hash_32u_shani_4way(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    sha256_hash_ways_shani(hash, H0, msgs, msg_lens, 8, 4);
+}
+
+#endif /* LV_HAVE_SHA && LV_HAVE_SSE4_1 */
+
+#endif /* INCLUDED_volk_sha256_8u_x8_hash_32u_a_H */
@@ -0,0 +1,142 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_sha1_32u.h>
+#include <volk_sha256/volk_sha256_8u_x8_hash_32u.h>
+
+/*
+ * NOTE:
+ * SHA-1 of eight independent messages msgs[0..7] with the lengths msg_lens[0..7] in bytes.
+ * The hash of message i is written to hash[5*i] to hash[5*i+4].
+ * The AVX2 implementation runs one message per 32 bit lane and shares the block loading, the lane-wise
+ * padding and the masking of finished lanes with volk_sha256_8u_x8_hash_32u, only the rounds differ.
+ */
+
+#ifndef INCLUDED_volk_sha256_8u_x8_sha1_32u_a_H
+#define INCLUDED_volk_sha256_8u_x8_sha1_32u_a_H
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void
+volk_sha256_8u_x8_sha1_32u_generic(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    unsigned int i;
+    for(i=0; i<8; i++) sha1_hash_blocks(hash + 5*i, msgs[i], msg_lens[i], sha1_process_blocks_generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+/* AVX2: Single round in the sha1 main loop on eight messages, F is CH_AVX2, XOR3_AVX2 or MAJ_AVX2 */
+#define SHA1_ROUND_AVX2(a, b, c, d, e, F, K, W)                                                 \
+e = _mm256_add_epi32(_mm256_add_epi32(e, ROTR_AVX2(a, 27)), _mm256_add_epi32(F(b, c, d),        \
+    _mm256_add_epi32(W, K)));                                                                   \
+b = ROTR_AVX2(b, 2)
+
+/* AVX2: Calculate W[t] in place of W[t-16] if the round needs it */
+#define SHA1_SCHEDULE_AVX2(W, t)                                                                \
+if((t) >= 16) W[(t)&15] = ROTR_AVX2(XOR3_AVX2(W[((t)-3)&15], W[((t)-8)&15],                    \
+    _mm256_xor_si256(W[((t)-14)&15], W[(t)&15])), 31)
+
+/* AVX2: Five rounds of one group, renaming a to e back to their initial positions */
+#define SHA1_ROUNDS5_AVX2(F, K, t)                                                              \
+SHA1_SCHEDULE_AVX2(W, t);                                                                       \
+SHA1_ROUND_AVX2(a, b, c, d, e, F, K, W[(t)&15]);                                                \
+SHA1_SCHEDULE_AVX2(W, (t)+1);                                                                   \
+SHA1_ROUND_AVX2(e, a, b, c, d, F, K, W[((t)+1)&15]);                                            \
+SHA1_SCHEDULE_AVX2(W, (t)+2);                                                                   \
+SHA1_ROUND_AVX2(d, e, a, b, c, F, K, W[((t)+2)&15]);                                            \
+SHA1_SCHEDULE_AVX2(W, (t)+3);                                                                   \
+SHA1_ROUND_AVX2(c, d, e, a, b, F, K, W[((t)+3)&15]);                                            \
+SHA1_SCHEDULE_AVX2(W, (t)+4);                                                                   \
+SHA1_ROUND_AVX2(b, c, d, e, a, F, K, W[((t)+4)&15])
+
+/* AVX2: Process one block of 512 bits of eight messages, the hash in state[0] to state[4] is only updated
+ * in the active lanes */
+static inline void
+sha1_process_block_x8_avx2(__m256i* state, const uint8_t* const* blocks, __m256i active){
+    __m256i W[16], a, b, c, d, e, K;
+    unsigned int t;
+
+    sha256_load_blocks_x8_avx2(W, blocks);
+
+    // Init a to e
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+
+    // Four groups of 20 rounds with their own function and constant
+    K = _mm256_set1_epi32(SHA1_K0);
+    for(t=0; t<20; t+=5){
+        SHA1_ROUNDS5_AVX2(CH_AVX2, K, t);
+    }
+    K = _mm256_set1_epi32(SHA1_K1);
+    for(t=20; t<40; t+=5){
+        SHA1_ROUNDS5_AVX2(XOR3_AVX2, K, t);
+    }
+    K = _mm256_set1_epi32(SHA1_K2);
+    for(t=40; t<60; t+=5){
+        SHA1_ROUNDS5_AVX2(MAJ_AVX2, K, t);
+    }
+    K = _mm256_set1_epi32(SHA1_K3);
+    for(t=60; t<80; t+=5){
+        SHA1_ROUNDS5_AVX2(XOR3_AVX2, K, t);
+    }
+
+    // Get intermediate hash in the active lanes
+    state[0] = _mm256_blendv_epi8(state[0], _mm256_add_epi32(state[0], a), active);
+    state[1] = _mm256_blendv_epi8(state[1], _mm256_add_epi32(state[1], b), active);
+    state[2] = _mm256_blendv_epi8(state[2], _mm256_add_epi32(state[2], c), active);
+    state[3] = _mm256_blendv_epi8(state[3], _mm256_add_epi32(state[3], d), active);
+    state[4] = _mm256_blendv_epi8(state[4], _mm256_add_epi32(state[4], e), active);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+
+static inline void
+volk_sha256_8u_x8_sha1_32u_avx2(uint32_t* hash, const uint8_t* const* msgs, const unsigned int* msg_lens)
+{
+    const __m256i MASK = _mm256_set_epi32(0, 0, 0, -1, -1, -1, -1, -1); // five words per message
+    __m256i state[8];
+    unsigned int i;
+
+    for(i=0; i<8; i++) state[i] = _mm256_set1_epi32(H0_SHA1[i]);
+    sha256_run_lanes_x8_avx2(state, msgs, msg_lens, 0, sha1_process_block_x8_avx2);
+
+    // Transpose back to one hash per message, the hashes are packed with five words each
+    sha256_transpose8x8_avx2(state);
+    for(i=0; i<8; i++) _mm256_maskstore_epi32((int*) (hash + 5*i), MASK, state[i]);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_sha256_8u_x8_sha1_32u_a_H */
@@ -39,6 +39,30 @@ std::vector<volk_sha256_test_case_t> init_test_list(volk_sha256_test_params_t te
         //(VOLK_INIT_TEST(volk_sha256_32fc_s32f_x2_power_spectral_density_32f,   test_params))
         //(VOLK_INIT_TEST(volk_sha256_32f_null_32f, test_params))
         (VOLK_INIT_TEST(volk_sha256_8u_hash_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash64_puppet_32u, volk_sha256_8u_hash64_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash_short_puppet_32u, volk_sha256_8u_hash_short_32u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_32u_hash_32u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_32u_x2_hash_32u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_hash80_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_copy_hash_puppet_32u, volk_sha256_8u_copy_hash_32u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_multi_digest_32u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_hash224_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash_lanes4_puppet_32u, volk_sha256_8u_x4_hash_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash_lanes8_puppet_32u, volk_sha256_8u_x8_hash_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash_lanes16_puppet_32u, volk_sha256_8u_x16_hash_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash224_lanes8_puppet_32u, volk_sha256_8u_x8_hash224_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash224_lanes16_puppet_32u, volk_sha256_8u_x16_hash224_32u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_hash512_64u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_hash384_64u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_hash512t256_64u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash512_lanes4_puppet_64u, volk_sha256_8u_x4_hash512_64u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hash512_lanes8_puppet_64u, volk_sha256_8u_x8_hash512_64u, test_params))
+        (VOLK_INIT_TEST(volk_sha256_8u_sha1_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_sha1_lanes8_puppet_32u, volk_sha256_8u_x8_sha1_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hmac_puppet_32u, volk_sha256_8u_hmac_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hmac_verify_puppet_32u, volk_sha256_8u_hmac_verify_32u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_hkdf_expand_puppet_8u, volk_sha256_8u_hkdf_expand_8u, test_params))
+        (VOLK_INIT_PUPP(volk_sha256_8u_pbkdf2_puppet_8u, volk_sha256_8u_pbkdf2_8u, test_params))
         ;
 
     return test_cases;
@@ -2,6 +2,9 @@
 #define VOLK_QA_UTILS_H
 
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <inttypes.h>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -131,6 +134,68 @@ bool run_volk_sha256_tests(
     }
 #define VOLK_PROFILE(func, test_params, results) run_volk_sha256_tests(func##_get_func_desc(), (void (*)())func##_manual, std::string(#func), test_params, results, "NULL")
 #define VOLK_PUPPET_PROFILE(func, puppet_master_func, test_params, results) run_volk_sha256_tests(func##_get_func_desc(), (void (*)())func##_manual, std::string(#func), test_params, results, std::string(#puppet_master_func))
+/*!
+ * Check every implementation of a multi-buffer kernel available on this machine. Lane i hashes
+ * msg_lens[i] bytes of a pattern, lane 1 holds "abc", so msg_lens starts with 0 and 3. Lanes 0 and 1
+ * are compared with the digests of "" and "abc", every lane with the generic single message kernel.
+ * Returns 0 if all of them match, to be returned from the main of the QA.
+ */
+template <class word_t>
+int run_volk_sha256_lane_tests(
+    volk_sha256_func_desc_t desc,
+    void (*lanes_manual)(word_t*, const uint8_t* const*, const unsigned int*, const char*),
+    void (*single_manual)(word_t*, const uint8_t*, unsigned int, const char*),
+    const unsigned int *msg_lens, size_t n_lanes, size_t digest_words,
+    const word_t *test_hash_empty, const word_t *test_hash_abc)
+{
+    size_t alignment = volk_sha256_get_alignment();
+    size_t stride = 3;
+    for(size_t i=0; i<n_lanes; i++) if(msg_lens[i] > stride) stride = msg_lens[i];
+    uint8_t* buffer = (uint8_t*) volk_sha256_malloc(n_lanes*stride*sizeof(uint8_t), alignment);
+    std::vector<const uint8_t*> msgs(n_lanes);
+    for(size_t i=0; i<n_lanes; i++){
+        uint8_t* msg = buffer + stride*i;
+        for(size_t k=0; k<msg_lens[i]; k++) msg[k] = (uint8_t) (k*(i+1) + 7);
+        msgs[i] = msg;
+    }
+    memcpy(buffer + stride, "abc", 3);
+
+    word_t* hash = (word_t*) volk_sha256_malloc(n_lanes*digest_words*sizeof(word_t), alignment);
+    word_t* ref_hash = (word_t*) volk_sha256_malloc(digest_words*sizeof(word_t), alignment);
+    int ret = 0;
+
+    for(size_t i=0; i<desc.n_impls && !ret; i++){
+        memset(hash, 0x00, n_lanes*digest_words*sizeof(word_t));
+        lanes_manual(hash, &msgs[0], msg_lens, desc.impl_names[i]);
+
+        // Print hashes from function
+        std::cout << "Hashes " << desc.impl_names[i] << " (hex):" << std::endl;
+        for(size_t j=0; j<n_lanes; j++){
+            for(size_t k=0; k<digest_words; k++) printf("%#0*" PRIx64 " ", (int) (2*sizeof(word_t)), (uint64_t) hash[digest_words*j+k]);
+            std::cout << std::endl;
+        }
+
+        // Check against the known answers
+        for(size_t k=0; k<digest_words; k++){
+            if(hash[k]!=test_hash_empty[k] || hash[digest_words+k]!=test_hash_abc[k]) ret = 1;
+        }
+
+        // Check against the single message kernel
+        for(size_t j=0; j<n_lanes; j++){
+            single_manual(ref_hash, msgs[j], msg_lens[j], "generic");
+            for(size_t k=0; k<digest_words; k++){
+                if(hash[digest_words*j+k]!=ref_hash[k]) ret = 1;
+            }
+        }
+        if(ret) std::cout << "Wrong hashes of " << desc.impl_names[i] << std::endl;
+    }
+
+    volk_sha256_free(ref_hash);
+    volk_sha256_free(hash);
+    volk_sha256_free(buffer);
+    return ret;
+}
+
 typedef void (*volk_sha256_fn_1arg)(void *, unsigned int, const char*); //one input, operate in place
 typedef void (*volk_sha256_fn_2arg)(void *, void *, unsigned int, const char*);
 typedef void (*volk_sha256_fn_3arg)(void *, void *, void *, unsigned int, const char*);
@@ -0,0 +1,54 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init pairs of digests, the first pair is all zero
+    const unsigned int n = 11; // number of pairs, leaves a rest for the multi-lane implementations
+    size_t alignment = volk_sha256_get_alignment();
+    uint32_t* left = (uint32_t*) volk_sha256_malloc(8*n*sizeof(uint32_t), alignment);
+    uint32_t* right = (uint32_t*) volk_sha256_malloc(8*n*sizeof(uint32_t), alignment);
+    for(size_t k=0; k<8*n; k++){
+        left[k] = (k < 8) ? 0 : (uint32_t) (k*0x9e3779b9);
+        right[k] = (k < 8) ? 0 : (uint32_t) (k*0x85ebca6b + 1);
+    }
+
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*n*sizeof(uint32_t), alignment);
+    uint32_t* ref_hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+    uint8_t msg[64];
+
+    // Hash of 64 zero bytes generated by sha256sum
+    uint32_t test_hash_zero[8] = {0xf5a5fd42, 0xd16a2030, 0x2798ef6e, 0xd309979b, 0x43003d23, 0x20d9f0e8, 0xea9831a9, 0x2759fb4b};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_32u_x2_hash_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        memset(hash, 0x00, 8*n*sizeof(uint32_t));
+        volk_sha256_32u_x2_hash_32u_manual(hash, left, right, 8*n, desc.impl_names[i]);
+
+        // Print hash from function
+        std::cout << "Hash " << desc.impl_names[i] << " (hex): ";
+        for(size_t k=0; k<8; k++) printf("%#08x ", hash[k]);
+        std::cout << std::endl;
+
+        // Check against hash generated by sha256sum
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=test_hash_zero[k]) return 1;
+        }
+
+        // Check against the single message kernel on the concatenated digests in big endian format
+        for(size_t j=0; j<n; j++){
+            for(size_t k=0; k<32; k++){
+                msg[k] = left[8*j + k/4] >> (24 - 8*(k%4));
+                msg[32+k] = right[8*j + k/4] >> (24 - 8*(k%4));
+            }
+            volk_sha256_8u_hash_32u_manual(ref_hash, msg, 64, "generic");
+            for(size_t k=0; k<8; k++){
+                if(hash[8*j+k]!=ref_hash[k]) return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Lengths around the chunk of 64 blocks with and without padding rest
+    const unsigned int lens[] = {0, 1, 55, 64, 65, 4095, 4096, 4097, 10000, 70000};
+    const unsigned int max_len = 70000;
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* src = (uint8_t*) volk_sha256_malloc((max_len + 64)*sizeof(uint8_t), alignment);
+    uint8_t* dst = (uint8_t*) volk_sha256_malloc((max_len + 64)*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<max_len + 64; k++) src[k] = (uint8_t) rand();
+
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+    uint32_t ref_hash[8];
+
+    // Hash of the empty message generated by sha256sum
+    uint32_t test_hash_empty[8] = {0xe3b0c442, 0x98fc1c14, 0x9afbf4c8, 0x996fb924, 0x27ae41e4, 0x649b934c, 0xa495991b, 0x7852b855};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_copy_hash_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        // The unaligned implementations get different offsets for source and destination
+        const uint8_t* msg = desc.impl_alignment[i] ? src : src + 1;
+        uint8_t* copy = desc.impl_alignment[i] ? dst : dst + 3;
+        std::cout << "Test " << desc.impl_names[i] << std::endl;
+
+        for(size_t j=0; j<sizeof(lens)/sizeof(lens[0]); j++){
+            memset(dst, 0x00, max_len + 64);
+            volk_sha256_8u_copy_hash_32u_manual(hash, copy, msg, lens[j], desc.impl_names[i]);
+
+            // Check the copy and that nothing is written behind it
+            if(memcmp(copy, msg, lens[j]) || copy[lens[j]] != 0x00){
+                printf("Wrong copy of %u bytes\n", lens[j]);
+                return 1;
+            }
+
+            // Check against hash generated by sha256sum and the hash kernel
+            volk_sha256_8u_hash_32u_manual(ref_hash, msg, lens[j], "generic");
+            for(size_t k=0; k<8; k++){
+                if(hash[k]!=ref_hash[k] || (lens[j]==0 && hash[k]!=test_hash_empty[k])){
+                    printf("Wrong hash of %u bytes\n", lens[j]);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
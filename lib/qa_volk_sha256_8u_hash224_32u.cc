@@ -0,0 +1,47 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages covering the empty message, one and two padding blocks and multiple blocks
+    const char* msg_two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(1000*sizeof(uint8_t), alignment);
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+
+    // Hashes of "", "abc", the 56 byte message and the 1000 byte counter pattern generated by sha224sum
+    uint32_t test_hashes[4][7] = {
+        {0xd14a028c, 0x2a3a2bc9, 0x476102bb, 0x288234c4, 0x15a2b01f, 0x828ea62a, 0xc5b3e42f},
+        {0x23097d22, 0x3405d822, 0x8642a477, 0xbda255b3, 0x2aadbce4, 0xbda0b3f7, 0xe36c9da7},
+        {0x75388b16, 0x512776cc, 0x5dba5da1, 0xfd890150, 0xb0c6455c, 0xb4f58b19, 0x52522525},
+        {0xa968ec53, 0x8be9181b, 0xf5376d20, 0x057fcbfd, 0x9a684990, 0xfe1da8a4, 0x94847abf}};
+    const unsigned int msg_lens[4] = {0, 3, 56, 1000};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash224_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        for(size_t j=0; j<4; j++){
+            if(j == 1) memcpy(msg, "abc", 3);
+            else if(j == 2) memcpy(msg, msg_two_blocks, 56);
+            else for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+
+            // The eighth word must stay untouched
+            memset(hash, 0x00, 8*sizeof(uint32_t));
+            volk_sha256_8u_hash224_32u_manual(hash, msg, msg_lens[j], desc.impl_names[i]);
+
+            // Print hash from function
+            std::cout << "Hash " << desc.impl_names[i] << " of " << msg_lens[j] << " bytes (hex): ";
+            for(size_t k=0; k<7; k++) printf("%#08x ", hash[k]);
+            std::cout << std::endl;
+
+            // Check against hash generated by sha224sum
+            for(size_t k=0; k<7; k++){
+                if(hash[k]!=test_hashes[j][k]) return 1;
+            }
+            if(hash[7]!=0) return 1;
+        }
+    }
+    return 0;
+}
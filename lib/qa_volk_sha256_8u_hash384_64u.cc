@@ -0,0 +1,47 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages covering the empty message, one and two padding blocks and multiple blocks
+    const char* msg_two_blocks = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(1000*sizeof(uint8_t), alignment);
+    uint64_t* hash = (uint64_t*) volk_sha256_malloc(8*sizeof(uint64_t), alignment);
+
+    // Hashes of "", "abc", the 112 byte message and the 1000 byte counter pattern generated by sha384sum
+    uint64_t test_hashes[4][6] = {
+        {0x38b060a751ac9638ULL, 0x4cd9327eb1b1e36aULL, 0x21fdb71114be0743ULL, 0x4c0cc7bf63f6e1daULL, 0x274edebfe76f65fbULL, 0xd51ad2f14898b95bULL},
+        {0xcb00753f45a35e8bULL, 0xb5a03d699ac65007ULL, 0x272c32ab0eded163ULL, 0x1a8b605a43ff5bedULL, 0x8086072ba1e7cc23ULL, 0x58baeca134c825a7ULL},
+        {0x09330c33f71147e8ULL, 0x3d192fc782cd1b47ULL, 0x53111b173b3b05d2ULL, 0x2fa08086e3b0f712ULL, 0xfcc7c71a557e2db9ULL, 0x66c3e9fa91746039ULL},
+        {0xcb07aeaff9a69e9aULL, 0x09f63b0f32587aecULL, 0xe51b58ebffcfc84eULL, 0xfb449057373d3b57ULL, 0xb3054267d86611f3ULL, 0xbfc1513699a189d7ULL}};
+    const unsigned int msg_lens[4] = {0, 3, 112, 1000};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash384_64u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        for(size_t j=0; j<4; j++){
+            if(j == 1) memcpy(msg, "abc", 3);
+            else if(j == 2) memcpy(msg, msg_two_blocks, 112);
+            else for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+
+            // The words after the hash must stay untouched
+            memset(hash, 0x00, 8*sizeof(uint64_t));
+            volk_sha256_8u_hash384_64u_manual(hash, msg, msg_lens[j], desc.impl_names[i]);
+
+            // Print hash from function
+            std::cout << "Hash " << desc.impl_names[i] << " of " << msg_lens[j] << " bytes (hex): ";
+            for(size_t k=0; k<6; k++) printf("%#016" PRIx64 " ", hash[k]);
+            std::cout << std::endl;
+
+            // Check against hash generated by sha384sum
+            for(size_t k=0; k<6; k++){
+                if(hash[k]!=test_hashes[j][k]) return 1;
+            }
+            if(hash[6]!=0) return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages covering the empty message, one and two padding blocks and multiple blocks
+    const char* msg_two_blocks = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(1000*sizeof(uint8_t), alignment);
+    uint64_t* hash = (uint64_t*) volk_sha256_malloc(8*sizeof(uint64_t), alignment);
+
+    // Hashes of "", "abc", the 112 byte message and the 1000 byte counter pattern generated by sha512sum
+    uint64_t test_hashes[4][8] = {
+        {0xcf83e1357eefb8bdULL, 0xf1542850d66d8007ULL, 0xd620e4050b5715dcULL, 0x83f4a921d36ce9ceULL, 0x47d0d13c5d85f2b0ULL, 0xff8318d2877eec2fULL, 0x63b931bd47417a81ULL, 0xa538327af927da3eULL},
+        {0xddaf35a193617abaULL, 0xcc417349ae204131ULL, 0x12e6fa4e89a97ea2ULL, 0x0a9eeee64b55d39aULL, 0x2192992a274fc1a8ULL, 0x36ba3c23a3feebbdULL, 0x454d4423643ce80eULL, 0x2a9ac94fa54ca49fULL},
+        {0x8e959b75dae313daULL, 0x8cf4f72814fc143fULL, 0x8f7779c6eb9f7fa1ULL, 0x7299aeadb6889018ULL, 0x501d289e4900f7e4ULL, 0x331b99dec4b5433aULL, 0xc7d329eeb6dd2654ULL, 0x5e96e55b874be909ULL},
+        {0xbcc96e2d34dee870ULL, 0x65c77c2fcf04195dULL, 0x958056c7dbb28c2bULL, 0x9619be124e3fcdc5ULL, 0xc824a499edae2014ULL, 0x63539dca2fcb18c7ULL, 0xa76f508b628e3552ULL, 0xc706146a274d57aeULL}};
+    const unsigned int msg_lens[4] = {0, 3, 112, 1000};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash512_64u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        for(size_t j=0; j<4; j++){
+            if(j == 1) memcpy(msg, "abc", 3);
+            else if(j == 2) memcpy(msg, msg_two_blocks, 112);
+            else for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+
+            memset(hash, 0x00, 8*sizeof(uint64_t));
+            volk_sha256_8u_hash512_64u_manual(hash, msg, msg_lens[j], desc.impl_names[i]);
+
+            // Print hash from function
+            std::cout << "Hash " << desc.impl_names[i] << " of " << msg_lens[j] << " bytes (hex): ";
+            for(size_t k=0; k<8; k++) printf("%#016" PRIx64 " ", hash[k]);
+            std::cout << std::endl;
+
+            // Check against hash generated by sha512sum
+            for(size_t k=0; k<8; k++){
+                if(hash[k]!=test_hashes[j][k]) return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages covering the empty message, one and two padding blocks and multiple blocks
+    const char* msg_two_blocks = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(1000*sizeof(uint8_t), alignment);
+    uint64_t* hash = (uint64_t*) volk_sha256_malloc(8*sizeof(uint64_t), alignment);
+
+    // Hashes of "", "abc", the 112 byte message and the 1000 byte counter pattern generated by openssl dgst -sha512-256
+    uint64_t test_hashes[4][4] = {
+        {0xc672b8d1ef56ed28ULL, 0xab87c3622c511406ULL, 0x9bdd3ad7b8f97374ULL, 0x98d0c01ecef0967aULL},
+        {0x53048e2681941ef9ULL, 0x9b2e29b76b4c7dabULL, 0xe4c2d0c634fc6d46ULL, 0xe0e2f13107e7af23ULL},
+        {0x3928e184fb8690f8ULL, 0x40da3988121d31beULL, 0x65cb9d3ef83ee614ULL, 0x6feac861e19b563aULL},
+        {0x546a36c9dd980c7eULL, 0xa1eb1a3a314ae32cULL, 0x1b8f29fd3afd6aaaULL, 0xdbce741c8c5fed9dULL}};
+    const unsigned int msg_lens[4] = {0, 3, 112, 1000};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash512t256_64u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        for(size_t j=0; j<4; j++){
+            if(j == 1) memcpy(msg, "abc", 3);
+            else if(j == 2) memcpy(msg, msg_two_blocks, 112);
+            else for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+
+            // The words after the hash must stay untouched
+            memset(hash, 0x00, 8*sizeof(uint64_t));
+            volk_sha256_8u_hash512t256_64u_manual(hash, msg, msg_lens[j], desc.impl_names[i]);
+
+            // Print hash from function
+            std::cout << "Hash " << desc.impl_names[i] << " of " << msg_lens[j] << " bytes (hex): ";
+            for(size_t k=0; k<4; k++) printf("%#016" PRIx64 " ", hash[k]);
+            std::cout << std::endl;
+
+            // Check against hash generated by openssl dgst -sha512-256
+            for(size_t k=0; k<4; k++){
+                if(hash[k]!=test_hashes[j][k]) return 1;
+            }
+            if(hash[4]!=0) return 1;
+        }
+    }
+    return 0;
+}
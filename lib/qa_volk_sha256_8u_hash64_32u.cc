@@ -0,0 +1,82 @@
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_prefetch.h>
+#define LV_HAVE_GENERIC
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages covering the empty message, one and two padding blocks and multiple blocks
+    const unsigned int msg_lens[4] = {0, 3, 56, 1000};
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(1000*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+    uint32_t* ref_hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+
+    // Hash of "abc" generated by sha256sum
+    uint32_t test_hash_abc[8] = {0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash64_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        // Check against hash generated by sha256sum
+        memcpy(msg, "abc", 3);
+        volk_sha256_8u_hash64_32u_manual(hash, msg, (uint64_t) 3, desc.impl_names[i]);
+        std::cout << "Hash " << desc.impl_names[i] << " (hex): ";
+        for(size_t k=0; k<8; k++) printf("%#08x ", hash[k]);
+        std::cout << std::endl;
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=test_hash_abc[k]) return 1;
+        }
+
+        // Check against the kernel with 32 bit lengths
+        for(size_t j=0; j<4; j++){
+            volk_sha256_8u_hash64_32u_manual(hash, msg, (uint64_t) msg_lens[j], desc.impl_names[i]);
+            volk_sha256_8u_hash_32u_manual(ref_hash, msg, msg_lens[j], "generic");
+            for(size_t k=0; k<8; k++){
+                if(hash[k]!=ref_hash[k]) return 1;
+            }
+        }
+    }
+
+    // The prefetch distance must not change the hash, also with lines beyond the end of the message
+    const unsigned int large_len = 100000;
+    const unsigned int distances[4] = {0, 100, 4096, 1u << 20};
+    uint8_t* large_msg = (uint8_t*) volk_sha256_malloc(large_len*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<large_len; k++) large_msg[k] = (uint8_t) (k*5 + 1);
+    volk_sha256_8u_hash_32u_manual(ref_hash, large_msg, large_len, "generic");
+    for(size_t i=0; i<desc.n_impls; i++){
+        if(!strstr(desc.impl_names[i], "_prefetch")) continue;
+        for(size_t j=0; j<4; j++){
+            volk_sha256_set_prefetch_distance(distances[j]);
+            volk_sha256_8u_hash64_32u_manual(hash, large_msg, (uint64_t) large_len, desc.impl_names[i]);
+            if(memcmp(hash, ref_hash, 8*sizeof(uint32_t))){
+                printf("Wrong hash of %s with prefetch distance %u\n", desc.impl_names[i], distances[j]);
+                return 1;
+            }
+        }
+    }
+    // The length block of messages of 512 MiB and more, whose length in bits needs more than 32 bits.
+    // Every implementation pads through sha256_hash_blocks_mid, which takes the prefix in front of the
+    // message as an intermediate hash, so a large prefix_len checks the encoding without hashing gigabytes.
+    // The expected hashes continue from H0 and are computed with an independent reference compression.
+    const uint64_t prefix_lens[3] = {1ull << 29, (1ull << 32) + 64, (1ull << 35) - 64};
+    const unsigned int rest_lens[3] = {3, 100, 60};
+    const uint32_t test_hash_mid[3][8] = {
+        {0x744e0e0f, 0x6327730f, 0x7c9fabe0, 0x0ce14816, 0xbc74928a, 0x5d356fac, 0xce08501f, 0x48b44329},
+        {0x8d67b441, 0x917575ce, 0x1f05b542, 0x1b739542, 0x010533ca, 0xb76a2b45, 0x28e87100, 0x15e5a061},
+        {0xfe68d938, 0x2ade708e, 0x3d9887a2, 0xb74b724c, 0xe335690f, 0x6fc91408, 0x6ab039aa, 0x047dc08d}};
+    for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+    for(size_t j=0; j<3; j++){
+        sha256_hash_blocks_mid(hash, H0, prefix_lens[j], msg, rest_lens[j], sha256_process_blocks_generic);
+        if(memcmp(hash, test_hash_mid[j], 8*sizeof(uint32_t))){
+            printf("Wrong length block after a prefix of %" PRIu64 " bytes\n", prefix_lens[j]);
+            return 1;
+        }
+    }
+    return 0;
+}
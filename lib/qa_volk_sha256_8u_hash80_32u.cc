@@ -0,0 +1,45 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages of 80 bytes, the first one is all zero
+    const unsigned int n = 11; // number of messages, leaves a rest for the multi-lane implementations
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(80*n*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<80*n; k++) msg[k] = (k < 80) ? 0 : (uint8_t) (k*7 + 3);
+
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*n*sizeof(uint32_t), alignment);
+    uint32_t* ref_hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+
+    // Hash of 80 zero bytes generated by sha256sum
+    uint32_t test_hash_zero[8] = {0x5b6fb58e, 0x61fa4759, 0x39767d68, 0xa446f97f, 0x1bff02c0, 0xe5935a3e, 0xa8bb51e6, 0x515783d8};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash80_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        memset(hash, 0x00, 8*n*sizeof(uint32_t));
+        volk_sha256_8u_hash80_32u_manual(hash, msg, 80*n, desc.impl_names[i]);
+
+        // Print hash from function
+        std::cout << "Hash " << desc.impl_names[i] << " (hex): ";
+        for(size_t k=0; k<8; k++) printf("%#08x ", hash[k]);
+        std::cout << std::endl;
+
+        // Check against hash generated by sha256sum
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=test_hash_zero[k]) return 1;
+        }
+
+        // Check against the single message kernel
+        for(size_t j=0; j<n; j++){
+            volk_sha256_8u_hash_32u_manual(ref_hash, msg + 80*j, 80, "generic");
+            for(size_t k=0; k<8; k++){
+                if(hash[8*j+k]!=ref_hash[k]) return 1;
+            }
+        }
+    }
+    return 0;
+}
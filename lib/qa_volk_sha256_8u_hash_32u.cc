@@ -17,18 +17,23 @@ int main(){
 
     uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
 
-    // Run generic kernel
-    volk_sha256_8u_hash_32u_manual(hash, msg, msg_len, "generic");
+    // Hash generated by sha256sum
+    uint32_t test_hash[8] = {0x048aaad6, 0x7b9200d2, 0x00293f13, 0x65474e76, 0x1fbfaca0, 0xd1e11fb5, 0xb059ed04, 0xd57d0d4a};
 
-    // Print hash from function
-    std::cout << "Hash (hex): ";
-    for(size_t k=0; k<8; k++) printf("%#08x ", hash[k]);
-    std::cout << std::endl;
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        volk_sha256_8u_hash_32u_manual(hash, msg, msg_len, desc.impl_names[i]);
 
-    // Check against hash generated by sha256sum
-    uint32_t test_hash[8] = {0x048aaad6, 0x7b9200d2, 0x00293f13, 0x65474e76, 0x1fbfaca0, 0xd1e11fb5, 0xb059ed04, 0xd57d0d4a};
-    for(size_t k=0; k<8; k++){
-        if(hash[k]!=test_hash[k]) return 1;
+        // Print hash from function
+        std::cout << "Hash " << desc.impl_names[i] << " (hex): ";
+        for(size_t k=0; k<8; k++) printf("%#08x ", hash[k]);
+        std::cout << std::endl;
+
+        // Check against hash generated by sha256sum
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=test_hash[k]) return 1;
+        }
     }
     return 0;
 }
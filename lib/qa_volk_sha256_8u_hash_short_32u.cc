@@ -0,0 +1,48 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init a message which covers every single block length and the first lengths of the multi-block path
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(64*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<64; k++) msg[k] = (uint8_t) (k*3 + 7);
+    memcpy(msg, "abc", 3);
+
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+    uint32_t* ref_hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+
+    // Hashes of "" and "abc" generated by sha256sum
+    uint32_t test_hash_empty[8] = {0xe3b0c442, 0x98fc1c14, 0x9afbf4c8, 0x996fb924, 0x27ae41e4, 0x649b934c, 0xa495991b, 0x7852b855};
+    uint32_t test_hash_abc[8] = {0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash_short_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        // Check against hashes generated by sha256sum
+        volk_sha256_8u_hash_short_32u_manual(hash, msg, 0, desc.impl_names[i]);
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=test_hash_empty[k]) return 1;
+        }
+        volk_sha256_8u_hash_short_32u_manual(hash, msg, 3, desc.impl_names[i]);
+        std::cout << "Hash " << desc.impl_names[i] << " (hex): ";
+        for(size_t k=0; k<8; k++) printf("%#08x ", hash[k]);
+        std::cout << std::endl;
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=test_hash_abc[k]) return 1;
+        }
+
+        // Check every length up to 55 and the longer lengths 56 to 64, which take the multi-block path,
+        // against the single message kernel
+        for(unsigned int len=0; len<=64; len++){
+            volk_sha256_8u_hash_short_32u_manual(hash, msg, len, desc.impl_names[i]);
+            volk_sha256_8u_hash_32u_manual(ref_hash, msg, len, "generic");
+            for(size_t k=0; k<8; k++){
+                if(hash[k]!=ref_hash[k]) return 1;
+            }
+        }
+    }
+    return 0;
+}
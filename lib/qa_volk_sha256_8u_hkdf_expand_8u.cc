@@ -0,0 +1,135 @@
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_hkdf.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Test cases 1 to 3 of RFC 5869, the first OKM bytes of a longer output are the OKM of a shorter one
+    const unsigned int ikm_lens[3] = {22, 80, 22};
+    const unsigned int salt_lens[3] = {13, 80, 0};
+    const unsigned int info_lens[3] = {10, 80, 0};
+    const unsigned int okm_lens[3] = {42, 82, 42};
+    const uint8_t test_prks[3][32] = {
+        {0x07, 0x77, 0x09, 0x36, 0x2c, 0x2e, 0x32, 0xdf, 0x0d, 0xdc, 0x3f, 0x0d, 0xc4, 0x7b, 0xba, 0x63,
+         0x90, 0xb6, 0xc7, 0x3b, 0xb5, 0x0f, 0x9c, 0x31, 0x22, 0xec, 0x84, 0x4a, 0xd7, 0xc2, 0xb3, 0xe5},
+        {0x06, 0xa6, 0xb8, 0x8c, 0x58, 0x53, 0x36, 0x1a, 0x06, 0x10, 0x4c, 0x9c, 0xeb, 0x35, 0xb4, 0x5c,
+         0xef, 0x76, 0x00, 0x14, 0x90, 0x46, 0x71, 0x01, 0x4a, 0x19, 0x3f, 0x40, 0xc1, 0x5f, 0xc2, 0x44},
+        {0x19, 0xef, 0x24, 0xa3, 0x2c, 0x71, 0x7b, 0x16, 0x7f, 0x33, 0xa9, 0x1d, 0x6f, 0x64, 0x8b, 0xdf,
+         0x96, 0x59, 0x67, 0x76, 0xaf, 0xdb, 0x63, 0x77, 0xac, 0x43, 0x4c, 0x1c, 0x29, 0x3c, 0xcb, 0x04}};
+    const uint8_t test_okms[3][82] = {
+        {0x3c, 0xb2, 0x5f, 0x25, 0xfa, 0xac, 0xd5, 0x7a, 0x90, 0x43, 0x4f, 0x64, 0xd0, 0x36, 0x2f, 0x2a,
+         0x2d, 0x2d, 0x0a, 0x90, 0xcf, 0x1a, 0x5a, 0x4c, 0x5d, 0xb0, 0x2d, 0x56, 0xec, 0xc4, 0xc5, 0xbf,
+         0x34, 0x00, 0x72, 0x08, 0xd5, 0xb8, 0x87, 0x18, 0x58, 0x65},
+        {0xb1, 0x1e, 0x39, 0x8d, 0xc8, 0x03, 0x27, 0xa1, 0xc8, 0xe7, 0xf7, 0x8c, 0x59, 0x6a, 0x49, 0x34,
+         0x4f, 0x01, 0x2e, 0xda, 0x2d, 0x4e, 0xfa, 0xd8, 0xa0, 0x50, 0xcc, 0x4c, 0x19, 0xaf, 0xa9, 0x7c,
+         0x59, 0x04, 0x5a, 0x99, 0xca, 0xc7, 0x82, 0x72, 0x71, 0xcb, 0x41, 0xc6, 0x5e, 0x59, 0x0e, 0x09,
+         0xda, 0x32, 0x75, 0x60, 0x0c, 0x2f, 0x09, 0xb8, 0x36, 0x77, 0x93, 0xa9, 0xac, 0xa3, 0xdb, 0x71,
+         0xcc, 0x30, 0xc5, 0x81, 0x79, 0xec, 0x3e, 0x87, 0xc1, 0x4c, 0x01, 0xd5, 0xc1, 0xf3, 0x43, 0x4f,
+         0x1d, 0x87},
+        {0x8d, 0xa4, 0xe7, 0x75, 0xa5, 0x63, 0xc1, 0x8f, 0x71, 0x5f, 0x80, 0x2a, 0x06, 0x3c, 0x5a, 0x31,
+         0xb8, 0xa1, 0x1f, 0x5c, 0x5e, 0xe1, 0x87, 0x9e, 0xc3, 0x45, 0x4e, 0x5f, 0x3c, 0x73, 0x8d, 0x2d,
+         0x9d, 0x20, 0x13, 0x95, 0xfa, 0xa4, 0xb6, 0x1a, 0x96, 0xc8}};
+
+    // 11 sessions cycle through the test cases and leave a partly filled last batch of lanes
+    const unsigned int count = 11;
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* ikm = (uint8_t*) volk_sha256_malloc(80*sizeof(uint8_t), alignment);
+    uint8_t* salt = (uint8_t*) volk_sha256_malloc(80*sizeof(uint8_t), alignment);
+    uint8_t* info = (uint8_t*) volk_sha256_malloc(3*80*sizeof(uint8_t), alignment);
+    uint8_t* okm = (uint8_t*) volk_sha256_malloc(count*82*sizeof(uint8_t), alignment);
+    uint8_t prks[3][32];
+    const uint8_t* session_prks[count];
+    const uint8_t* session_infos[count];
+    unsigned int session_info_lens[count];
+
+    // Extract the PRKs, the input bytes count up from 0x0b, 0x00, 0x60 and 0xb0
+    for(size_t j=0; j<3; j++){
+        for(size_t k=0; k<ikm_lens[j]; k++) ikm[k] = (j == 1) ? (uint8_t) k : 0x0b;
+        for(size_t k=0; k<salt_lens[j]; k++) salt[k] = (uint8_t) (((j == 1) ? 0x60 : 0x00) + k);
+        for(size_t k=0; k<info_lens[j]; k++) info[80*j+k] = (uint8_t) (((j == 1) ? 0xb0 : 0xf0) + k);
+        volk_sha256_hkdf_extract(prks[j], salt_lens[j] ? salt : NULL, salt_lens[j], ikm, ikm_lens[j]);
+
+        std::cout << "PRK of test case " << j+1 << " (hex): ";
+        for(size_t k=0; k<32; k++) printf("%02x", prks[j][k]);
+        std::cout << std::endl;
+        if(memcmp(prks[j], test_prks[j], 32)) return 1;
+    }
+    for(size_t i=0; i<count; i++){
+        session_prks[i] = prks[i % 3];
+        session_infos[i] = info + 80*(i % 3);
+        session_info_lens[i] = info_lens[i % 3];
+    }
+
+    // Run every implementation available on this machine and the batch API
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hkdf_expand_8u_get_func_desc();
+    for(size_t i=0; i<=desc.n_impls; i++){
+        memset(okm, 0x00, count*82*sizeof(uint8_t));
+        if(i < desc.n_impls) volk_sha256_8u_hkdf_expand_8u_manual(okm, session_prks, session_infos, session_info_lens, 82, count, desc.impl_names[i]);
+        else if(volk_sha256_hkdf_expand_batch(okm, 82, session_prks, session_infos, session_info_lens, count)) return 1;
+
+        // Check against RFC 5869
+        std::cout << "OKM " << ((i < desc.n_impls) ? desc.impl_names[i] : "dispatcher") << " of " << count << " sessions" << std::endl;
+        for(size_t k=0; k<count; k++){
+            if(memcmp(okm + 82*k, test_okms[k % 3], okm_lens[k % 3])) return 1;
+        }
+    }
+
+    // Single sessions with the exact output lengths
+    for(size_t j=0; j<3; j++){
+        memset(okm, 0x00, 82*sizeof(uint8_t));
+        if(volk_sha256_hkdf_expand(okm, okm_lens[j], prks[j], info_lens[j] ? info + 80*j : NULL, info_lens[j])) return 1;
+        if(memcmp(okm, test_okms[j], okm_lens[j])) return 1;
+        for(size_t k=okm_lens[j]; k<82; k++){
+            if(okm[k]) return 1;
+        }
+    }
+
+    // A context info spanning many blocks with the PRK of test case 1, OKM generated by Python's hmac module.
+    // Odd sessions take the info of test case 1, so the lanes of a batch run different numbers of blocks
+    const unsigned int long_info_len = 1055;
+    const uint8_t test_okm_long[82] = {
+        0x47, 0xe8, 0x0e, 0xda, 0xd1, 0x42, 0xc2, 0xff, 0x9e, 0x58, 0xac, 0xfd, 0x20, 0x49, 0xfb, 0xb2,
+        0xad, 0xcc, 0x29, 0xb9, 0x82, 0x06, 0xbc, 0xb7, 0xbc, 0x63, 0xd9, 0x0d, 0xe2, 0x6d, 0xc1, 0xd8,
+        0x72, 0xaa, 0xaf, 0xdf, 0xaa, 0x6b, 0xcd, 0xac, 0xe5, 0xa4, 0xca, 0x5f, 0x38, 0xb2, 0xdb, 0xd7,
+        0xb2, 0x27, 0x58, 0x0a, 0xe1, 0xbd, 0x7f, 0xbb, 0x29, 0x26, 0xe5, 0xa5, 0xe8, 0x1d, 0x14, 0xc2,
+        0xf7, 0x88, 0x0d, 0xbb, 0x5f, 0x40, 0xec, 0xde, 0x9b, 0xdd, 0x95, 0xb5, 0x3a, 0x17, 0xfe, 0x8f,
+        0xc1, 0xc6};
+    uint8_t* long_info = (uint8_t*) volk_sha256_malloc(long_info_len*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<long_info_len; k++) long_info[k] = (uint8_t) (k*7 + 1);
+    for(size_t i=0; i<count; i++){
+        session_prks[i] = prks[0];
+        session_infos[i] = (i % 2) ? info : long_info;
+        session_info_lens[i] = (i % 2) ? info_lens[0] : long_info_len;
+    }
+    for(size_t i=0; i<=desc.n_impls; i++){
+        memset(okm, 0x00, count*82*sizeof(uint8_t));
+        if(i < desc.n_impls) volk_sha256_8u_hkdf_expand_8u_manual(okm, session_prks, session_infos, session_info_lens, 82, count, desc.impl_names[i]);
+        else if(volk_sha256_hkdf_expand_batch(okm, 82, session_prks, session_infos, session_info_lens, count)) return 1;
+
+        std::cout << "OKM " << ((i < desc.n_impls) ? desc.impl_names[i] : "dispatcher") << " with a context info of " << long_info_len << " bytes" << std::endl;
+        for(size_t k=0; k<count; k++){
+            if(memcmp(okm + 82*k, (k % 2) ? test_okms[0] : test_okm_long, (k % 2) ? okm_lens[0] : 82)) return 1;
+        }
+    }
+
+    // More than 255 blocks of output are rejected, the kernel leaves the output untouched
+    uint8_t* okm_max = (uint8_t*) volk_sha256_malloc((VOLK_SHA256_HKDF_MAX_OKM_LEN + 1)*sizeof(uint8_t), alignment);
+    memset(okm_max, 0x00, (VOLK_SHA256_HKDF_MAX_OKM_LEN + 1)*sizeof(uint8_t));
+    if(volk_sha256_hkdf_expand(okm_max, VOLK_SHA256_HKDF_MAX_OKM_LEN + 1, prks[0], info, info_lens[0]) != -1) return 1;
+    for(size_t i=0; i<desc.n_impls; i++){
+        volk_sha256_8u_hkdf_expand_8u_manual(okm_max, session_prks, session_infos, session_info_lens, VOLK_SHA256_HKDF_MAX_OKM_LEN + 1, 1, desc.impl_names[i]);
+    }
+    for(size_t k=0; k<VOLK_SHA256_HKDF_MAX_OKM_LEN + 1; k++){
+        if(okm_max[k]) return 1;
+    }
+
+    volk_sha256_free(ikm);
+    volk_sha256_free(salt);
+    volk_sha256_free(info);
+    volk_sha256_free(long_info);
+    volk_sha256_free(okm);
+    volk_sha256_free(okm_max);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_hmac.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Test cases 1, 2, 3, 4, 6 and 7 of RFC 4231, the repeated bytes are filled in below
+    const unsigned int key_lens[6] = {20, 4, 20, 25, 131, 131};
+    const unsigned int msg_lens[6] = {8, 28, 50, 50, 54, 152};
+    const char* key_text[6] = {NULL, "Jefe", NULL, NULL, NULL, NULL};
+    const char* msg_text[6] = {"Hi There", "what do ya want for nothing?", NULL, NULL,
+        "Test Using Larger Than Block-Size Key - Hash Key First",
+        "This is a test using a larger than block-size key and a larger than block-size data. "
+        "The key needs to be hashed before being used by the HMAC algorithm."};
+    const uint8_t key_fill[6] = {0x0b, 0x00, 0xaa, 0x00, 0xaa, 0xaa};
+    const uint8_t msg_fill[6] = {0x00, 0x00, 0xdd, 0xcd, 0x00, 0x00};
+    uint32_t test_macs[6][8] = {
+        {0xb0344c61, 0xd8db3853, 0x5ca8afce, 0xaf0bf12b, 0x881dc200, 0xc9833da7, 0x26e9376c, 0x2e32cff7},
+        {0x5bdcc146, 0xbf60754e, 0x6a042426, 0x089575c7, 0x5a003f08, 0x9d273983, 0x9dec58b9, 0x64ec3843},
+        {0x773ea91e, 0x36800e46, 0x854db8eb, 0xd09181a7, 0x2959098b, 0x3ef8c122, 0xd9635514, 0xced565fe},
+        {0x82558a38, 0x9a443c0e, 0xa4cc8198, 0x99f2083a, 0x85f0faa3, 0xe578f807, 0x7a2e3ff4, 0x6729665b},
+        {0x60e43159, 0x1ee0b67f, 0x0d8a26aa, 0xcbf5b77f, 0x8e0bc621, 0x3728c514, 0x0546040f, 0x0ee37f54},
+        {0x9b09ffa7, 0x1b942fcb, 0x27635fbc, 0xd5b0e944, 0xbfdc6364, 0x4f071393, 0x8a7f5153, 0x5c3a35e2}};
+
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* key = (uint8_t*) volk_sha256_malloc(256*sizeof(uint8_t), alignment);
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(256*sizeof(uint8_t), alignment);
+    uint32_t* mac = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+    volk_sha256_hmac_key_t hmac_key;
+
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hmac_32u_get_func_desc();
+    for(size_t j=0; j<6; j++){
+        if(key_text[j]) memcpy(key, key_text[j], key_lens[j]);
+        else if(j == 3) for(size_t k=0; k<key_lens[j]; k++) key[k] = (uint8_t) (k + 1);
+        else memset(key, key_fill[j], key_lens[j]);
+        if(msg_text[j]) memcpy(msg, msg_text[j], msg_lens[j]);
+        else memset(msg, msg_fill[j], msg_lens[j]);
+        volk_sha256_hmac_key_init(&hmac_key, key, key_lens[j]);
+
+        // Run every implementation available on this machine and the dispatcher
+        for(size_t i=0; i<=desc.n_impls; i++){
+            memset(mac, 0x00, 8*sizeof(uint32_t));
+            if(i < desc.n_impls) volk_sha256_8u_hmac_32u_manual(mac, hmac_key.state, msg, msg_lens[j], desc.impl_names[i]);
+            else volk_sha256_hmac(mac, &hmac_key, msg, msg_lens[j]);
+
+            // Print MAC from function
+            std::cout << "MAC " << ((i < desc.n_impls) ? desc.impl_names[i] : "dispatcher") << " of test case " << j << " (hex): ";
+            for(size_t k=0; k<8; k++) printf("%#08x ", mac[k]);
+            std::cout << std::endl;
+
+            // Check against RFC 4231
+            for(size_t k=0; k<8; k++){
+                if(mac[k]!=test_macs[j][k]) return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_hmac.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // 37 messages cover a partly filled last batch of lanes and two words of the bitmap
+    const unsigned int count = 37;
+    const unsigned int key_lens[3] = {5, 64, 100};
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* buffer = (uint8_t*) volk_sha256_malloc(count*300*sizeof(uint8_t), alignment);
+    uint8_t* key_bytes = (uint8_t*) volk_sha256_malloc(100*sizeof(uint8_t), alignment);
+    uint8_t* tags = (uint8_t*) volk_sha256_malloc(count*32*sizeof(uint8_t), alignment);
+    uint32_t* pass = (uint32_t*) volk_sha256_malloc(2*sizeof(uint32_t), alignment);
+    const uint8_t* msgs[count];
+    unsigned int msg_lens[count];
+    const uint32_t* key_states[count];
+    const volk_sha256_hmac_key_t* msg_keys[count];
+    volk_sha256_hmac_key_t keys[3];
+    uint32_t expected[2] = {0, 0};
+    uint32_t mac[8];
+
+    // Three keys around the block length
+    for(size_t i=0; i<3; i++){
+        for(size_t k=0; k<key_lens[i]; k++) key_bytes[k] = (uint8_t) (k*(i+3) + 1);
+        volk_sha256_hmac_key_init(&keys[i], key_bytes, key_lens[i]);
+    }
+
+    // Messages of lengths around one and two padding blocks, every fifth tag is wrong in one bit
+    for(size_t i=0; i<count; i++){
+        uint8_t* msg = buffer + 300*i;
+        msg_lens[i] = (unsigned int) ((i*37) % 300);
+        for(size_t k=0; k<msg_lens[i]; k++) msg[k] = (uint8_t) (k*(i+1) + 7);
+        msgs[i] = msg;
+        msg_keys[i] = &keys[i % 3];
+        key_states[i] = keys[i % 3].state;
+
+        volk_sha256_8u_hmac_32u_manual(mac, key_states[i], msgs[i], msg_lens[i], "generic");
+        for(size_t k=0; k<32; k++) tags[32*i+k] = (uint8_t) (mac[k/4] >> (24 - 8*(k%4)));
+        if(i % 5 == 2) tags[32*i + (i*7) % 32] ^= 0x10;
+        else expected[i/32] |= 1u << (i%32);
+    }
+
+    // Run every implementation available on this machine and the batch API
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hmac_verify_32u_get_func_desc();
+    for(size_t i=0; i<=desc.n_impls; i++){
+        memset(pass, 0xff, 2*sizeof(uint32_t));
+        if(i < desc.n_impls) volk_sha256_8u_hmac_verify_32u_manual(pass, key_states, msgs, msg_lens, tags, count, desc.impl_names[i]);
+        else volk_sha256_hmac_verify_batch(pass, msg_keys, msgs, msg_lens, tags, count);
+
+        // Print bitmap from function
+        std::cout << "Bitmap " << ((i < desc.n_impls) ? desc.impl_names[i] : "batch API") << " (hex): ";
+        printf("%#08x %#08x\n", pass[0], pass[1]);
+
+        if(pass[0]!=expected[0] || pass[1]!=expected[1]) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Lengths with one and two padding blocks and a rest of the CRC
+    const unsigned int lens[] = {0, 1, 3, 9, 55, 56, 63, 64, 65, 119, 120, 1000, 10000};
+    const unsigned int max_len = 10000;
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(max_len*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<max_len; k++) msg[k] = (uint8_t) rand();
+
+    uint32_t* digest = (uint32_t*) volk_sha256_malloc(16*sizeof(uint32_t), alignment);
+    uint32_t ref_digest[16], ref_hash[8];
+
+    // SHA-224 of "abc" generated by sha224sum and the CRC32C check value of "123456789"
+    const uint8_t msg_abc[] = "abc";
+    const uint8_t msg_check[] = "123456789";
+    uint32_t test_hash224_abc[7] = {0x23097d22, 0x3405d822, 0x8642a477, 0xbda255b3, 0x2aadbce4, 0xbda0b3f7, 0xe36c9da7};
+    uint32_t test_crc_check = 0xe3069283;
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_multi_digest_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        std::cout << "Test " << desc.impl_names[i] << std::endl;
+
+        volk_sha256_8u_multi_digest_32u_manual(digest, msg_abc, 3, desc.impl_names[i]);
+        for(size_t k=0; k<7; k++){
+            if(digest[8+k]!=test_hash224_abc[k]){
+                printf("Wrong SHA-224 of abc\n");
+                return 1;
+            }
+        }
+        volk_sha256_8u_multi_digest_32u_manual(digest, msg_check, 9, desc.impl_names[i]);
+        if(digest[15]!=test_crc_check){
+            printf("Wrong CRC32C of 123456789: %08x\n", digest[15]);
+            return 1;
+        }
+
+        // Check SHA-256 against the hash kernel and all digests against the generic implementation
+        for(size_t j=0; j<sizeof(lens)/sizeof(lens[0]); j++){
+            volk_sha256_8u_multi_digest_32u_manual(digest, msg, lens[j], desc.impl_names[i]);
+            volk_sha256_8u_multi_digest_32u_manual(ref_digest, msg, lens[j], "generic");
+            volk_sha256_8u_hash_32u_manual(ref_hash, msg, lens[j], "generic");
+            if(memcmp(digest, ref_hash, sizeof(ref_hash)) || memcmp(digest, ref_digest, 16*sizeof(uint32_t))){
+                printf("Wrong digests of %u bytes\n", lens[j]);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_pbkdf2.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Test vectors of RFC 7914 (the first two) and the PBKDF2-HMAC-SHA256 versions of the RFC 6070 vectors
+    const char* passwords[6] = {"passwd", "Password", "password", "password", "passwordPASSWORDpassword", "pass\0word"};
+    const unsigned int password_lens[6] = {6, 8, 8, 8, 24, 9};
+    const char* salt_text[6] = {"salt", "NaCl", "salt", "salt", "saltSALTsaltSALTsaltSALTsaltSALTsalt", "sa\0lt"};
+    const unsigned int salt_lens[6] = {4, 4, 4, 4, 36, 5};
+    const unsigned int iterations[6] = {1, 80000, 2, 4096, 4096, 4096};
+    const unsigned int dk_lens[6] = {64, 64, 32, 32, 40, 16};
+    // Sessions per batch, they cover partly filled last batches of the lanes and keep the 80000 iterations short
+    const unsigned int counts[6] = {9, 1, 5, 3, 9, 17};
+    const uint8_t test_dks[6][64] = {
+        {0x55, 0xac, 0x04, 0x6e, 0x56, 0xe3, 0x08, 0x9f, 0xec, 0x16, 0x91, 0xc2, 0x25, 0x44, 0xb6, 0x05,
+         0xf9, 0x41, 0x85, 0x21, 0x6d, 0xde, 0x04, 0x65, 0xe6, 0x8b, 0x9d, 0x57, 0xc2, 0x0d, 0xac, 0xbc,
+         0x49, 0xca, 0x9c, 0xcc, 0xf1, 0x79, 0xb6, 0x45, 0x99, 0x16, 0x64, 0xb3, 0x9d, 0x77, 0xef, 0x31,
+         0x7c, 0x71, 0xb8, 0x45, 0xb1, 0xe3, 0x0b, 0xd5, 0x09, 0x11, 0x20, 0x41, 0xd3, 0xa1, 0x97, 0x83},
+        {0x4d, 0xdc, 0xd8, 0xf6, 0x0b, 0x98, 0xbe, 0x21, 0x83, 0x0c, 0xee, 0x5e, 0xf2, 0x27, 0x01, 0xf9,
+         0x64, 0x1a, 0x44, 0x18, 0xd0, 0x4c, 0x04, 0x14, 0xae, 0xff, 0x08, 0x87, 0x6b, 0x34, 0xab, 0x56,
+         0xa1, 0xd4, 0x25, 0xa1, 0x22, 0x58, 0x33, 0x54, 0x9a, 0xdb, 0x84, 0x1b, 0x51, 0xc9, 0xb3, 0x17,
+         0x6a, 0x27, 0x2b, 0xde, 0xbb, 0xa1, 0xd0, 0x78, 0x47, 0x8f, 0x62, 0xb3, 0x97, 0xf3, 0x3c, 0x8d},
+        {0xae, 0x4d, 0x0c, 0x95, 0xaf, 0x6b, 0x46, 0xd3, 0x2d, 0x0a, 0xdf, 0xf9, 0x28, 0xf0, 0x6d, 0xd0,
+         0x2a, 0x30, 0x3f, 0x8e, 0xf3, 0xc2, 0x51, 0xdf, 0xd6, 0xe2, 0xd8, 0x5a, 0x95, 0x47, 0x4c, 0x43},
+        {0xc5, 0xe4, 0x78, 0xd5, 0x92, 0x88, 0xc8, 0x41, 0xaa, 0x53, 0x0d, 0xb6, 0x84, 0x5c, 0x4c, 0x8d,
+         0x96, 0x28, 0x93, 0xa0, 0x01, 0xce, 0x4e, 0x11, 0xa4, 0x96, 0x38, 0x73, 0xaa, 0x98, 0x13, 0x4a},
+        {0x34, 0x8c, 0x89, 0xdb, 0xcb, 0xd3, 0x2b, 0x2f, 0x32, 0xd8, 0x14, 0xb8, 0x11, 0x6e, 0x84, 0xcf,
+         0x2b, 0x17, 0x34, 0x7e, 0xbc, 0x18, 0x00, 0x18, 0x1c, 0x4e, 0x2a, 0x1f, 0xb8, 0xdd, 0x53, 0xe1,
+         0xc6, 0x35, 0x51, 0x8c, 0x7d, 0xac, 0x47, 0xe9},
+        {0x89, 0xb6, 0x9d, 0x05, 0x16, 0xf8, 0x29, 0x89, 0x3c, 0x69, 0x62, 0x26, 0x65, 0x0a, 0x86, 0x87}};
+
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* salt = (uint8_t*) volk_sha256_malloc(64*sizeof(uint8_t), alignment);
+    uint8_t* dk = (uint8_t*) volk_sha256_malloc(17*64*sizeof(uint8_t), alignment);
+    const uint32_t* key_states[17];
+    const volk_sha256_hmac_key_t* keys[17];
+    const uint8_t* salts[17];
+    unsigned int lens[17];
+    volk_sha256_hmac_key_t key;
+
+    volk_sha256_func_desc_t desc = volk_sha256_8u_pbkdf2_8u_get_func_desc();
+    for(size_t j=0; j<6; j++){
+        memcpy(salt, salt_text[j], salt_lens[j]);
+        volk_sha256_hmac_key_init(&key, (const uint8_t*) passwords[j], password_lens[j]);
+        for(size_t k=0; k<counts[j]; k++){
+            key_states[k] = key.state;
+            keys[k] = &key;
+            salts[k] = salt;
+            lens[k] = salt_lens[j];
+        }
+
+        // Run every implementation available on this machine, the batch API and the single password API
+        for(size_t i=0; i<=desc.n_impls+1; i++){
+            const unsigned int count = (i <= desc.n_impls) ? counts[j] : 1;
+            memset(dk, 0x00, 17*64*sizeof(uint8_t));
+            if(i < desc.n_impls) volk_sha256_8u_pbkdf2_8u_manual(dk, key_states, salts, lens, iterations[j], dk_lens[j], count, desc.impl_names[i]);
+            else if(i == desc.n_impls) {
+                if(volk_sha256_pbkdf2_batch(dk, dk_lens[j], keys, salts, lens, iterations[j], count)) return 1;
+            }
+            else if(volk_sha256_pbkdf2(dk, dk_lens[j], (const uint8_t*) passwords[j], password_lens[j], salt, salt_lens[j], iterations[j])) return 1;
+
+            std::cout << "DK " << ((i < desc.n_impls) ? desc.impl_names[i] : ((i == desc.n_impls) ? "batch" : "single"))
+                      << " of test case " << j << " (hex): ";
+            for(size_t k=0; k<dk_lens[j]; k++) printf("%02x", dk[k]);
+            std::cout << std::endl;
+
+            // Check every password of the batch against the test vector and that nothing is written behind it
+            for(size_t k=0; k<count; k++){
+                if(memcmp(dk + dk_lens[j]*k, test_dks[j], dk_lens[j])) return 1;
+            }
+            for(size_t k=dk_lens[j]*count; k<17*64; k++){
+                if(dk[k]) return 1;
+            }
+        }
+    }
+
+    // Salts of one and more blocks, with a different length on every lane, around the block and padding boundaries
+    const unsigned int long_salt_lens[9] = {55, 56, 63, 64, 100, 119, 120, 128, 300};
+    const uint8_t long_salt_dks[9][40] = {
+        {0x1c, 0xfe, 0x08, 0xc4, 0x04, 0x56, 0x06, 0x22, 0x60, 0x92, 0x12, 0x21, 0x61, 0x04, 0xbb, 0xb9,
+         0x84, 0x51, 0xfa, 0x8c, 0x4c, 0x9f, 0x00, 0x11, 0x2f, 0x8a, 0x01, 0x2d, 0xd1, 0x3b, 0x29, 0x73,
+         0xb5, 0xc1, 0x6e, 0xa4, 0x7c, 0xf9, 0xe3, 0x35},
+        {0x59, 0x74, 0x92, 0xe1, 0xe5, 0x83, 0x5f, 0x02, 0xf4, 0x2f, 0x7b, 0xcc, 0x34, 0x1a, 0xe3, 0xa1,
+         0x71, 0xe9, 0x95, 0x43, 0x1b, 0x80, 0xa2, 0xeb, 0x46, 0x78, 0x1d, 0x3c, 0x47, 0xaa, 0xb7, 0x15,
+         0x64, 0xd1, 0xe0, 0x6c, 0xf3, 0xc2, 0x29, 0x72},
+        {0x10, 0x44, 0x47, 0x0d, 0x82, 0x45, 0x17, 0x13, 0x57, 0x75, 0xf5, 0x80, 0x67, 0x8e, 0x8b, 0x08,
+         0xbb, 0x23, 0xbb, 0x9f, 0x17, 0xd1, 0x96, 0x02, 0x7d, 0xe7, 0x6b, 0xb7, 0x9f, 0xbf, 0xd8, 0x2a,
+         0xc0, 0x84, 0x44, 0xc4, 0xb0, 0x0c, 0x8e, 0x28},
+        {0xe9, 0x48, 0x66, 0x4c, 0x19, 0xf1, 0x37, 0x93, 0x90, 0xbb, 0x1b, 0xcc, 0x53, 0x58, 0x72, 0xa9,
+         0x7b, 0x8f, 0x84, 0xc8, 0x94, 0xde, 0x9d, 0x10, 0xa5, 0xdc, 0xc5, 0xd7, 0x16, 0x65, 0x1b, 0x8d,
+         0x4b, 0x42, 0xe8, 0x60, 0x20, 0x2b, 0xb9, 0x0c},
+        {0x02, 0x92, 0xbd, 0x0b, 0xf1, 0xbc, 0x9e, 0xf8, 0x12, 0xe4, 0x63, 0x24, 0xf7, 0x92, 0x94, 0xa6,
+         0xc8, 0xd2, 0xb5, 0xb6, 0x3f, 0x92, 0x02, 0xbb, 0xd2, 0x5a, 0x5a, 0x0f, 0x3b, 0xdd, 0x6f, 0x59,
+         0x6a, 0xdf, 0xf1, 0x03, 0x70, 0x7e, 0x18, 0x4a},
+        {0xaa, 0x33, 0xfc, 0x1e, 0xb0, 0x17, 0x3e, 0x67, 0x64, 0x40, 0xa5, 0x01, 0x6e, 0x09, 0x94, 0x50,
+         0xd5, 0x57, 0x56, 0x64, 0x37, 0x94, 0xd7, 0x63, 0xb3, 0x99, 0x8b, 0x29, 0x10, 0x0b, 0x19, 0x90,
+         0x96, 0x7e, 0x20, 0xfc, 0x3a, 0xa9, 0x87, 0x9f},
+        {0x48, 0x67, 0xb6, 0xc1, 0xfc, 0x7d, 0x1c, 0x9d, 0x3b, 0x15, 0x9f, 0x39, 0x7f, 0xb5, 0x40, 0x5c,
+         0xc2, 0xe8, 0x5e, 0xd0, 0x1f, 0x32, 0xc2, 0x6c, 0xe8, 0xaf, 0xd0, 0xa6, 0xb3, 0x78, 0xe6, 0x35,
+         0xf7, 0x83, 0x3b, 0xa7, 0x41, 0x07, 0xf0, 0xb1},
+        {0x78, 0x8e, 0x7e, 0x23, 0xdb, 0xba, 0xfd, 0x9a, 0xa1, 0xef, 0xf4, 0x27, 0x8c, 0xba, 0x2e, 0x00,
+         0x10, 0x15, 0xf8, 0xba, 0xaf, 0xaf, 0xeb, 0xf5, 0xdb, 0x9a, 0xe3, 0x9a, 0xc3, 0x45, 0x4a, 0x46,
+         0xe8, 0x50, 0x23, 0xb3, 0x65, 0x3c, 0x8e, 0x4c},
+        {0x43, 0xe7, 0x3c, 0xfe, 0xe5, 0xa1, 0x42, 0xa0, 0x20, 0x37, 0x92, 0x2f, 0x5d, 0x24, 0xb7, 0xbc,
+         0xdb, 0x2e, 0x88, 0x47, 0xcb, 0x5a, 0xfc, 0xdc, 0xfd, 0x1f, 0x83, 0x52, 0xc6, 0x8f, 0xef, 0xd0,
+         0xb2, 0x17, 0xd4, 0x11, 0x97, 0x18, 0xf1, 0xf6}};
+    uint8_t* long_salt = (uint8_t*) volk_sha256_malloc(300*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<300; k++) long_salt[k] = (uint8_t) (k*7 + 3);
+    volk_sha256_hmac_key_init(&key, (const uint8_t*) "password", 8);
+    for(size_t k=0; k<9; k++){
+        key_states[k] = key.state;
+        keys[k] = &key;
+        salts[k] = long_salt;
+        lens[k] = long_salt_lens[k];
+    }
+    for(size_t i=0; i<=desc.n_impls+1; i++){
+        const unsigned int count = (i <= desc.n_impls) ? 9 : 1;
+        memset(dk, 0x00, 17*64*sizeof(uint8_t));
+        if(i < desc.n_impls) volk_sha256_8u_pbkdf2_8u_manual(dk, key_states, salts, lens, 3, 40, count, desc.impl_names[i]);
+        else if(i == desc.n_impls) {
+            if(volk_sha256_pbkdf2_batch(dk, 40, keys, salts, lens, 3, count)) return 1;
+        }
+        else if(volk_sha256_pbkdf2(dk, 40, (const uint8_t*) "password", 8, long_salt, long_salt_lens[0], 3)) return 1;
+
+        std::cout << "DK " << ((i < desc.n_impls) ? desc.impl_names[i] : ((i == desc.n_impls) ? "batch" : "single"))
+                  << " of the long salts (hex): ";
+        for(size_t k=0; k<40; k++) printf("%02x", dk[k]);
+        std::cout << std::endl;
+
+        for(size_t k=0; k<count; k++){
+            if(memcmp(dk + 40*k, long_salt_dks[k], 40)) return 1;
+        }
+        for(size_t k=40*count; k<17*64; k++){
+            if(dk[k]) return 1;
+        }
+    }
+
+    // A zero iteration count is rejected
+    if(volk_sha256_pbkdf2(dk, 32, (const uint8_t*) passwords[0], password_lens[0], salt, salt_lens[0], 0) != -1) return 1;
+
+    volk_sha256_free(long_salt);
+    volk_sha256_free(salt);
+    volk_sha256_free(dk);
+    return 0;
+}
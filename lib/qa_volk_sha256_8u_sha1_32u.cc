@@ -0,0 +1,49 @@
+#include <volk_sha256/volk_sha256.h>
+#include <inttypes.h>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Init messages covering the empty message, one and two padding blocks and multiple blocks
+    const char* msg_two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc(1000*sizeof(uint8_t), alignment);
+    uint32_t* hash = (uint32_t*) volk_sha256_malloc(8*sizeof(uint32_t), alignment);
+
+    // Hashes of "", "abc", the 56 byte message and the 1000 byte counter pattern generated by sha1sum
+    uint32_t test_hashes[4][5] = {
+        {0xda39a3ee, 0x5e6b4b0d, 0x3255bfef, 0x95601890, 0xafd80709},
+        {0xa9993e36, 0x4706816a, 0xba3e2571, 0x7850c26c, 0x9cd0d89d},
+        {0x84983e44, 0x1c3bd26e, 0xbaae4aa1, 0xf95129e5, 0xe54670f1},
+        {0xc76b17bf, 0xa0f89c6e, 0xc02401f6, 0xfb9a71c8, 0xaddb55b9}};
+    const unsigned int msg_lens[4] = {0, 3, 56, 1000};
+
+    // Run every implementation available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_sha1_32u_get_func_desc();
+    for(size_t i=0; i<desc.n_impls; i++){
+        for(size_t j=0; j<4; j++){
+            if(j == 1) memcpy(msg, "abc", 3);
+            else if(j == 2) memcpy(msg, msg_two_blocks, 56);
+            else for(size_t k=0; k<1000; k++) msg[k] = (uint8_t) (k*3 + 7);
+
+            // The words after the hash must stay untouched
+            memset(hash, 0x00, 8*sizeof(uint32_t));
+            volk_sha256_8u_sha1_32u_manual(hash, msg, msg_lens[j], desc.impl_names[i]);
+
+            // Print hash from function
+            std::cout << "Hash " << desc.impl_names[i] << " of " << msg_lens[j] << " bytes (hex): ";
+            for(size_t k=0; k<5; k++) printf("%#08x ", hash[k]);
+            std::cout << std::endl;
+
+            // Check against hash generated by sha1sum
+            for(size_t k=0; k<5; k++){
+                if(hash[k]!=test_hashes[j][k]) return 1;
+            }
+            for(size_t k=5; k<8; k++){
+                if(hash[k]!=0) return 1;
+            }
+        }
+    }
+    return 0;
+}
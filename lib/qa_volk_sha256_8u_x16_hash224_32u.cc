@@ -0,0 +1,14 @@
+#include <volk_sha256/volk_sha256.h>
+#include "qa_utils.h"
+
+int main(){
+    // Sixteen messages with lengths covering empty messages, one and two padding blocks and multiple blocks
+    const unsigned int msg_lens[16] = {0, 3, 55, 56, 63, 64, 119, 1000, 1, 54, 57, 65, 128, 191, 500, 999};
+
+    // Hashes of "" and "abc" generated by sha224sum
+    uint32_t test_hash_empty[7] = {0xd14a028c, 0x2a3a2bc9, 0x476102bb, 0x288234c4, 0x15a2b01f, 0x828ea62a, 0xc5b3e42f};
+    uint32_t test_hash_abc[7] = {0x23097d22, 0x3405d822, 0x8642a477, 0xbda255b3, 0x2aadbce4, 0xbda0b3f7, 0xe36c9da7};
+
+    return run_volk_sha256_lane_tests(volk_sha256_8u_x16_hash224_32u_get_func_desc(), volk_sha256_8u_x16_hash224_32u_manual,
+        volk_sha256_8u_hash224_32u_manual, msg_lens, 16, 7, test_hash_empty, test_hash_abc);
+}
@@ -0,0 +1,14 @@
+#include <volk_sha256/volk_sha256.h>
+#include "qa_utils.h"
+
+int main(){
+    // Sixteen messages with lengths covering empty messages, one and two padding blocks and multiple blocks
+    const unsigned int msg_lens[16] = {0, 3, 55, 56, 63, 64, 119, 1000, 1, 54, 57, 65, 128, 191, 500, 999};
+
+    // Hashes of "" and "abc" generated by sha256sum
+    uint32_t test_hash_empty[8] = {0xe3b0c442, 0x98fc1c14, 0x9afbf4c8, 0x996fb924, 0x27ae41e4, 0x649b934c, 0xa495991b, 0x7852b855};
+    uint32_t test_hash_abc[8] = {0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad};
+
+    return run_volk_sha256_lane_tests(volk_sha256_8u_x16_hash_32u_get_func_desc(), volk_sha256_8u_x16_hash_32u_manual,
+        volk_sha256_8u_hash_32u_manual, msg_lens, 16, 8, test_hash_empty, test_hash_abc);
+}
@@ -0,0 +1,14 @@
+#include <volk_sha256/volk_sha256.h>
+#include "qa_utils.h"
+
+int main(){
+    // Eight messages with lengths covering empty messages, one and two padding blocks and multiple blocks
+    const unsigned int msg_lens[8] = {0, 3, 111, 112, 127, 128, 239, 1000};
+
+    // Hashes of "" and "abc" generated by sha512sum
+    uint64_t test_hash_empty[8] = {0xcf83e1357eefb8bdULL, 0xf1542850d66d8007ULL, 0xd620e4050b5715dcULL, 0x83f4a921d36ce9ceULL, 0x47d0d13c5d85f2b0ULL, 0xff8318d2877eec2fULL, 0x63b931bd47417a81ULL, 0xa538327af927da3eULL};
+    uint64_t test_hash_abc[8] = {0xddaf35a193617abaULL, 0xcc417349ae204131ULL, 0x12e6fa4e89a97ea2ULL, 0x0a9eeee64b55d39aULL, 0x2192992a274fc1a8ULL, 0x36ba3c23a3feebbdULL, 0x454d4423643ce80eULL, 0x2a9ac94fa54ca49fULL};
+
+    return run_volk_sha256_lane_tests(volk_sha256_8u_x8_hash512_64u_get_func_desc(), volk_sha256_8u_x8_hash512_64u_manual,
+        volk_sha256_8u_hash512_64u_manual, msg_lens, 8, 8, test_hash_empty, test_hash_abc);
+}
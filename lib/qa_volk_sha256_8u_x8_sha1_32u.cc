@@ -0,0 +1,14 @@
+#include <volk_sha256/volk_sha256.h>
+#include "qa_utils.h"
+
+int main(){
+    // Eight messages with lengths covering empty messages, one and two padding blocks and multiple blocks
+    const unsigned int msg_lens[8] = {0, 3, 55, 56, 63, 64, 119, 1000};
+
+    // Hashes of "" and "abc" generated by sha1sum
+    uint32_t test_hash_empty[5] = {0xda39a3ee, 0x5e6b4b0d, 0x3255bfef, 0x95601890, 0xafd80709};
+    uint32_t test_hash_abc[5] = {0xa9993e36, 0x4706816a, 0xba3e2571, 0x7850c26c, 0x9cd0d89d};
+
+    return run_volk_sha256_lane_tests(volk_sha256_8u_x8_sha1_32u_get_func_desc(), volk_sha256_8u_x8_sha1_32u_manual,
+        volk_sha256_8u_sha1_32u_manual, msg_lens, 8, 5, test_hash_empty, test_hash_abc);
+}
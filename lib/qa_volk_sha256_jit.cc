@@ -0,0 +1,66 @@
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_jit.h>
+#include <inttypes.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+int main(){
+    // Run only if the jit implementation is available on this machine
+    volk_sha256_func_desc_t desc = volk_sha256_8u_hash_32u_get_func_desc();
+    bool has_jit = false;
+    for(size_t i=0; i<desc.n_impls; i++) has_jit |= !strcmp(desc.impl_names[i], "jit");
+    if(!has_jit){
+        std::cout << "No jit implementation on this machine" << std::endl;
+        return 0;
+    }
+
+    // Init random message, the lengths cover every tail and one or more full blocks
+    const unsigned int max_len = 1000;
+    size_t alignment = volk_sha256_get_alignment();
+    uint8_t* msg = (uint8_t*) volk_sha256_malloc((max_len + 1)*sizeof(uint8_t), alignment);
+    for(size_t k=0; k<=max_len; k++) msg[k] = (uint8_t) rand();
+
+    // Lengths around the tail sizes 0, 8, 16, 32, 55, 56 and 63 with zero, one and more full blocks
+    const unsigned int lens[] = {0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 55, 56, 57, 63, 64, 65, 80, 119, 120,
+                                 127, 128, 129, 192, 255, 256, 300, 511, 999};
+    uint32_t hash[8], ref_hash[8];
+    unsigned int n_compiled = 0;
+    for(size_t i=0; i<sizeof(lens)/sizeof(lens[0]); i++){
+        const unsigned int len = lens[i];
+        if(volk_sha256_jit_compile(len)) continue; // registry full or no SHA-NI
+        n_compiled++;
+
+        // Compare the kernel on the unaligned tail of the buffer with the generic implementation
+        volk_sha256_8u_hash_32u_manual(hash, msg + 1, len, "jit");
+        volk_sha256_8u_hash_32u_manual(ref_hash, msg + 1, len, "generic");
+        for(size_t k=0; k<8; k++){
+            if(hash[k]!=ref_hash[k]){
+                printf("Mismatch for length %u\n", len);
+                return 1;
+            }
+        }
+    }
+    std::cout << "Compiled " << n_compiled << " lengths" << std::endl;
+
+    // Lengths without generated code take the fallback
+    volk_sha256_8u_hash_32u_manual(hash, msg, max_len, "jit");
+    volk_sha256_8u_hash_32u_manual(ref_hash, msg, max_len, "generic");
+    if(memcmp(hash, ref_hash, sizeof(hash))) return 1;
+
+    // Fill the registry, every compiled length is found in the index and the 65th length is refused
+    for(unsigned int len = 2000; n_compiled < 64; len++){
+        if(volk_sha256_jit_compile(len)) return 1;
+        n_compiled++;
+    }
+    if(volk_sha256_jit_compile(5000) != -1) return 1;
+    for(size_t i=0; i<sizeof(lens)/sizeof(lens[0]); i++){
+        if(!volk_sha256_jit_get(lens[i])) return 1;
+    }
+    if(volk_sha256_jit_get(5000)) return 1;
+
+    volk_sha256_jit_free();
+    if(volk_sha256_jit_get(lens[0])) return 1;
+    return 0;
+}
@@ -0,0 +1,59 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <volk_sha256/volk_sha256_hkdf.h>
+#include <volk_sha256/volk_sha256_hmac.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hkdf_expand_8u.h>
+
+void volk_sha256_hkdf_extract(uint8_t* prk, const uint8_t* salt, unsigned int salt_len,
+                              const uint8_t* ikm, unsigned int ikm_len)
+{
+    volk_sha256_hmac_key_t key;
+    uint32_t mac[8];
+    unsigned int i;
+
+    // A salt of zero bytes gives the same key block as HashLen zero bytes
+    volk_sha256_hmac_key_init(&key, salt, salt_len);
+    volk_sha256_hmac(mac, &key, ikm, ikm_len);
+    for(i = 0; i < 8; i++) {
+        prk[4 * i] = (uint8_t)(mac[i] >> 24);
+        prk[4 * i + 1] = (uint8_t)(mac[i] >> 16);
+        prk[4 * i + 2] = (uint8_t)(mac[i] >> 8);
+        prk[4 * i + 3] = (uint8_t) mac[i];
+    }
+}
+
+int volk_sha256_hkdf_expand(uint8_t* okm, unsigned int okm_len, const uint8_t* prk,
+                            const uint8_t* info, unsigned int info_len)
+{
+    return volk_sha256_hkdf_expand_batch(okm, okm_len, &prk, &info, &info_len, 1);
+}
+
+int volk_sha256_hkdf_expand_batch(uint8_t* okm, unsigned int okm_len, const uint8_t* const* prks,
+                                  const uint8_t* const* infos, const unsigned int* info_lens,
+                                  unsigned int count)
+{
+    if(okm_len > VOLK_SHA256_HKDF_MAX_OKM_LEN) return -1;
+    volk_sha256_8u_hkdf_expand_8u(okm, prks, infos, info_lens, okm_len, count);
+    return 0;
+}
@@ -0,0 +1,52 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <volk_sha256/volk_sha256_hmac.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_hmac_32u.h>
+
+/* Number of messages whose key states are gathered at once, a multiple of the 32 bits of a bitmap word */
+#define VOLK_SHA256_HMAC_VERIFY_CHUNK 64
+
+void volk_sha256_hmac_key_init(volk_sha256_hmac_key_t* key, const uint8_t* key_bytes, unsigned int key_len)
+{
+    sha256_hmac_key_states(key->state, key_bytes, key_len);
+}
+
+void volk_sha256_hmac(uint32_t* mac, const volk_sha256_hmac_key_t* key, const uint8_t* msg, unsigned int msg_len)
+{
+    volk_sha256_8u_hmac_32u(mac, key->state, msg, msg_len);
+}
+
+void volk_sha256_hmac_verify_batch(uint32_t* pass, const volk_sha256_hmac_key_t* const* keys,
+                                   const uint8_t* const* msgs, const unsigned int* msg_lens,
+                                   const uint8_t* tags, unsigned int count)
+{
+    const uint32_t* key_states[VOLK_SHA256_HMAC_VERIFY_CHUNK];
+    unsigned int i, j, n;
+
+    for(i = 0; i < count; i += n) {
+        n = (count - i < VOLK_SHA256_HMAC_VERIFY_CHUNK) ? count - i : VOLK_SHA256_HMAC_VERIFY_CHUNK;
+        for(j = 0; j < n; j++) key_states[j] = keys[i + j]->state;
+        volk_sha256_8u_hmac_verify_32u(pass + i / 32, key_states, msgs + i, msg_lens + i, tags + 32 * i, n);
+    }
+}
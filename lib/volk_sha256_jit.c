@@ -0,0 +1,450 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <volk_sha256/volk_sha256_jit.h>
+#include <volk_sha256/volk_sha256_cpu.h>
+#include <volk_sha256/volk_sha256_8u_hash_32u.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * NOTE:
+ * Code generator for SHA-NI functions hashing messages of one fixed length. The function has the
+ * signature of volk_sha256_jit_func_t in the System V calling convention and keeps the register
+ * layout of kernels/volk_sha256/asm/sha: xmm0 takes the round words, the state lives in xmm1, xmm2
+ * in the ABEF, CDGH layout of sha256rnds2, the message words in xmm3 to xmm6, the byte swap mask in
+ * xmm7, the saved state in xmm8, xmm9 and scratch in xmm10. rax points to the constant pool in front
+ * of the code, the padding block with the message tail is assembled in the red zone below rsp.
+ */
+
+#if defined(__x86_64__) && (defined(__unix__) || defined(__APPLE__)) && !defined(_WIN32)
+#define VOLK_SHA256_JIT_SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+/* Maximum number of message lengths with generated code */
+#define SHA256_JIT_MAX_FUNCS 64
+
+/* Slots of the open addressing index from the message length to the function, at least twice the functions */
+#define SHA256_JIT_INDEX_BITS 7
+#define SHA256_JIT_INDEX_SIZE (1u << SHA256_JIT_INDEX_BITS)
+
+/* Size of the executable mapping of one function: constant pool, then code */
+#define SHA256_JIT_MAP_SIZE 16384
+#define SHA256_JIT_CODE_OFFSET 1024
+
+/* Offsets of the constant pool, all 16 byte aligned for the memory operands of legacy SSE */
+#define SHA256_JIT_POOL_K 0
+#define SHA256_JIT_POOL_MASK 256
+#define SHA256_JIT_POOL_H0 272
+#define SHA256_JIT_POOL_TAIL 304
+#define SHA256_JIT_POOL_WK 368
+
+#ifdef VOLK_SHA256_JIT_SUPPORTED
+
+/* Slot of the index, used is published last with a release store, so a reader seeing it sees the whole slot */
+typedef struct {
+    unsigned int msg_len;
+    volk_sha256_jit_func_t func;
+    int used;
+} sha256_jit_slot_t;
+
+/* Executable mappings of the generated functions, owned by the compiling thread under the lock */
+static void* sha256_jit_maps[SHA256_JIT_MAX_FUNCS];
+static unsigned int sha256_jit_n_maps = 0;
+static sha256_jit_slot_t sha256_jit_index[SHA256_JIT_INDEX_SIZE];
+static pthread_mutex_t sha256_jit_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* First slot probed for a message length, Fibonacci hashing spreads consecutive lengths */
+static unsigned int
+sha256_jit_slot(unsigned int msg_len){
+    return (uint32_t) (msg_len * 0x9e3779b1u) >> (32 - SHA256_JIT_INDEX_BITS);
+}
+
+volk_sha256_jit_func_t volk_sha256_jit_get(unsigned int msg_len)
+{
+    unsigned int i = sha256_jit_slot(msg_len);
+
+    // Lock free, the index is never fuller than half, so a probe ends at an empty slot after a few steps
+    while(__atomic_load_n(&sha256_jit_index[i].used, __ATOMIC_ACQUIRE)){
+        if(sha256_jit_index[i].msg_len == msg_len) return sha256_jit_index[i].func;
+        i = (i + 1) & (SHA256_JIT_INDEX_SIZE - 1);
+    }
+    return NULL;
+}
+
+/* Registers by their number in the instruction encoding */
+enum { RAX = 0, RCX = 1, RDX = 2, RSP = 4, RSI = 6, RDI = 7 };
+enum { WK = 0, STATE0 = 1, STATE1 = 2, MSG0 = 3, MSG1 = 4, MSG2 = 5, MSG3 = 6, MASK = 7, ABEF = 8, CDGH = 9, TMP = 10 };
+
+/* Register operand instead of a memory operand */
+#define NO_BASE (-1)
+
+/* Legacy SSE instructions: mandatory prefix and opcode after 0x0F, has_imm if an imm8 follows */
+typedef struct { uint8_t prefix; uint8_t op[2]; uint8_t n_op; uint8_t has_imm; } sha256_jit_sse_t;
+
+static const sha256_jit_sse_t MOVDQU_LOAD  = {0xF3, {0x6F, 0x00}, 1, 0};
+static const sha256_jit_sse_t MOVDQU_STORE = {0xF3, {0x7F, 0x00}, 1, 0};
+static const sha256_jit_sse_t MOVDQA_LOAD  = {0x66, {0x6F, 0x00}, 1, 0};
+static const sha256_jit_sse_t PADDD        = {0x66, {0xFE, 0x00}, 1, 0};
+static const sha256_jit_sse_t PSHUFD       = {0x66, {0x70, 0x00}, 1, 1};
+static const sha256_jit_sse_t PSHUFB       = {0x66, {0x38, 0x00}, 2, 0};
+static const sha256_jit_sse_t PALIGNR      = {0x66, {0x3A, 0x0F}, 2, 1};
+static const sha256_jit_sse_t PBLENDW      = {0x66, {0x3A, 0x0E}, 2, 1};
+static const sha256_jit_sse_t SHA256RNDS2  = {0x00, {0x38, 0xCB}, 2, 0};
+static const sha256_jit_sse_t SHA256MSG1   = {0x00, {0x38, 0xCC}, 2, 0};
+static const sha256_jit_sse_t SHA256MSG2   = {0x00, {0x38, 0xCD}, 2, 0};
+
+typedef struct {
+    uint8_t* code;
+    size_t size;
+    size_t capacity;
+} sha256_jit_asm_t;
+
+static void
+sha256_jit_emit8(sha256_jit_asm_t* a, uint8_t byte){
+    if(a->size < a->capacity) a->code[a->size] = byte;
+    a->size++; // an overflow is detected by the caller
+}
+
+static void
+sha256_jit_emit32(sha256_jit_asm_t* a, uint32_t word){
+    unsigned int i;
+    for(i=0; i<4; i++) sha256_jit_emit8(a, (uint8_t) (word >> 8*i));
+}
+
+/* ModRM with a register operand or a memory operand [base + disp32] */
+static void
+sha256_jit_emit_modrm(sha256_jit_asm_t* a, int reg, int rm, int base, int32_t disp){
+    if(base == NO_BASE){
+        sha256_jit_emit8(a, 0xC0 | (reg & 7) << 3 | (rm & 7));
+        return;
+    }
+    sha256_jit_emit8(a, 0x80 | (reg & 7) << 3 | base);
+    if(base == RSP) sha256_jit_emit8(a, 0x24); // SIB without index
+    sha256_jit_emit32(a, (uint32_t) disp);
+}
+
+/* SSE instruction reg, rm or reg, [base + disp32] */
+static void
+sha256_jit_emit_sse(sha256_jit_asm_t* a, const sha256_jit_sse_t* ins, int reg, int rm, int base, int32_t disp, uint8_t imm){
+    unsigned int i;
+    const int rex_b = (base == NO_BASE) ? (rm >> 3) : 0;
+    if(ins->prefix) sha256_jit_emit8(a, ins->prefix);
+    if((reg >> 3) | rex_b) sha256_jit_emit8(a, 0x40 | (reg >> 3) << 2 | rex_b);
+    sha256_jit_emit8(a, 0x0F);
+    for(i=0; i<ins->n_op; i++) sha256_jit_emit8(a, ins->op[i]);
+    sha256_jit_emit_modrm(a, reg, rm, base, disp);
+    if(ins->has_imm) sha256_jit_emit8(a, imm);
+}
+
+#define SSE_RR(a, ins, dst, src) sha256_jit_emit_sse(a, &ins, dst, src, NO_BASE, 0, 0)
+#define SSE_RRI(a, ins, dst, src, imm) sha256_jit_emit_sse(a, &ins, dst, src, NO_BASE, 0, imm)
+#define SSE_RM(a, ins, reg, base, disp) sha256_jit_emit_sse(a, &ins, reg, 0, base, disp, 0)
+
+/* mov of width bytes between rdx and [base + disp32] */
+static void
+sha256_jit_emit_mov_rdx(sha256_jit_asm_t* a, unsigned int width, int store, int base, int32_t disp){
+    if(width == 2) sha256_jit_emit8(a, 0x66);
+    if(width == 8) sha256_jit_emit8(a, 0x48); // REX.W
+    sha256_jit_emit8(a, (store ? 0x88 : 0x8A) | (width > 1));
+    sha256_jit_emit_modrm(a, RDX, 0, base, disp);
+}
+
+/* Four rounds with the message words m */
+static void
+sha256_jit_emit_rounds4(sha256_jit_asm_t* a, int m, int k){
+    SSE_RR(a, MOVDQA_LOAD, WK, m);
+    SSE_RM(a, PADDD, WK, RAX, SHA256_JIT_POOL_K + 4*k);
+    SSE_RR(a, SHA256RNDS2, STATE1, STATE0);
+    SSE_RRI(a, PSHUFD, WK, WK, 0x0E);
+    SSE_RR(a, SHA256RNDS2, STATE0, STATE1);
+}
+
+/* Four rounds with the message words m0 while calculating the next words in m1 and preparing m3 */
+static void
+sha256_jit_emit_rounds4_msg(sha256_jit_asm_t* a, int m0, int m1, int m3, int k){
+    SSE_RR(a, MOVDQA_LOAD, WK, m0);
+    SSE_RM(a, PADDD, WK, RAX, SHA256_JIT_POOL_K + 4*k);
+    SSE_RR(a, SHA256RNDS2, STATE1, STATE0);
+    SSE_RR(a, MOVDQA_LOAD, TMP, m0);
+    SSE_RRI(a, PALIGNR, TMP, m3, 4);
+    SSE_RR(a, PADDD, m1, TMP);
+    SSE_RR(a, SHA256MSG2, m1, m0);
+    SSE_RRI(a, PSHUFD, WK, WK, 0x0E);
+    SSE_RR(a, SHA256RNDS2, STATE0, STATE1);
+    SSE_RR(a, SHA256MSG1, m3, m0);
+}
+
+/* One block read from [base + disp] */
+static void
+sha256_jit_emit_block(sha256_jit_asm_t* a, int base, int32_t disp){
+    const int msg[4] = {MSG0, MSG1, MSG2, MSG3};
+    int i;
+
+    SSE_RR(a, MOVDQA_LOAD, ABEF, STATE0);
+    SSE_RR(a, MOVDQA_LOAD, CDGH, STATE1);
+
+    // First 16 rounds take the message directly
+    for(i=0; i<4; i++){
+        SSE_RM(a, MOVDQU_LOAD, msg[i], base, disp + 16*i);
+        SSE_RR(a, PSHUFB, msg[i], MASK);
+        if(i < 3) sha256_jit_emit_rounds4(a, msg[i], 4*i);
+        if(i > 0 && i < 3) SSE_RR(a, SHA256MSG1, msg[i-1], msg[i]);
+    }
+
+    // Remaining rounds calculate W on the fly
+    for(i=3; i<15; i++) sha256_jit_emit_rounds4_msg(a, msg[i%4], msg[(i+1)%4], msg[(i+3)%4], 4*i);
+    sha256_jit_emit_rounds4(a, MSG3, 60);
+
+    SSE_RR(a, PADDD, STATE0, ABEF);
+    SSE_RR(a, PADDD, STATE1, CDGH);
+}
+
+/* One block without message bytes, the round words come from the constant pool */
+static void
+sha256_jit_emit_const_block(sha256_jit_asm_t* a){
+    int i;
+
+    SSE_RR(a, MOVDQA_LOAD, ABEF, STATE0);
+    SSE_RR(a, MOVDQA_LOAD, CDGH, STATE1);
+    for(i=0; i<16; i++){
+        SSE_RM(a, MOVDQA_LOAD, WK, RAX, SHA256_JIT_POOL_WK + 16*i);
+        SSE_RR(a, SHA256RNDS2, STATE1, STATE0);
+        SSE_RRI(a, PSHUFD, WK, WK, 0x0E);
+        SSE_RR(a, SHA256RNDS2, STATE0, STATE1);
+    }
+    SSE_RR(a, PADDD, STATE0, ABEF);
+    SSE_RR(a, PADDD, STATE1, CDGH);
+}
+
+/* Copy R message bytes from [rsi] to the red zone block at [rsp - 64] */
+static void
+sha256_jit_emit_copy_tail(sha256_jit_asm_t* a, unsigned int R){
+    unsigned int offset = 0, width;
+
+    if(R >= 8){
+        // 8 byte moves, the last one overlaps the previous instead of splitting the rest
+        for(; offset < R; offset += 8){
+            if(offset + 8 > R) offset = R - 8;
+            sha256_jit_emit_mov_rdx(a, 8, 0, RSI, offset);
+            sha256_jit_emit_mov_rdx(a, 8, 1, RSP, (int32_t) offset - 64);
+        }
+        return;
+    }
+    for(width = 4; width > 0; width /= 2){
+        if(R - offset < width) continue;
+        sha256_jit_emit_mov_rdx(a, width, 0, RSI, offset);
+        sha256_jit_emit_mov_rdx(a, width, 1, RSP, (int32_t) offset - 64);
+        offset += width;
+    }
+}
+
+/* Fill the constant pool for a message of msg_len bytes */
+static void
+sha256_jit_fill_pool(uint8_t* pool, unsigned int msg_len){
+    const unsigned int R = msg_len % 64;
+    const uint64_t mask[2] = {0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL};
+    const uint32_t h0_abef[4] = {H0[5], H0[4], H0[1], H0[0]};
+    const uint32_t h0_cdgh[4] = {H0[7], H0[6], H0[3], H0[2]};
+    uint8_t tail[128];
+    const uint8_t zeros[64] = {0};
+    const unsigned int n = sha256_pad_tail(tail, zeros, R, (uint64_t) msg_len * 8);
+    uint32_t W[64];
+    unsigned int t;
+
+    memcpy(pool + SHA256_JIT_POOL_K, K, sizeof(K));
+    memcpy(pool + SHA256_JIT_POOL_MASK, mask, sizeof(mask));
+    memcpy(pool + SHA256_JIT_POOL_H0, h0_abef, sizeof(h0_abef));
+    memcpy(pool + SHA256_JIT_POOL_H0 + 16, h0_cdgh, sizeof(h0_cdgh));
+
+    // Padding block receiving the message tail
+    memcpy(pool + SHA256_JIT_POOL_TAIL, tail, 64);
+
+    // Last padding block without message bytes, W + K in the order sha256rnds2 takes it
+    memcpy(W, tail + 64*(n - 1), 64);
+    for(t=0; t<16; t++) W[t] = SWAP_UINT32(W[t]);
+    for(t=16; t<64; t++) W[t] = SIGMA_1(W[t-2]) + W[t-7] + SIGMA_0(W[t-15]) + W[t-16];
+    for(t=0; t<64; t++) W[t] += K[t];
+    memcpy(pool + SHA256_JIT_POOL_WK, W, sizeof(W));
+}
+
+/* Emit the function for a message of msg_len bytes, pool is the address of the constant pool */
+static void
+sha256_jit_emit_func(sha256_jit_asm_t* a, const uint8_t* pool, unsigned int msg_len){
+    const unsigned int N = msg_len / 64;
+    const unsigned int R = msg_len % 64;
+    size_t loop;
+    unsigned int i;
+
+    // mov rax, pool
+    sha256_jit_emit8(a, 0x48);
+    sha256_jit_emit8(a, 0xB8);
+    sha256_jit_emit32(a, (uint32_t) (uintptr_t) pool);
+    sha256_jit_emit32(a, (uint32_t) ((uint64_t) (uintptr_t) pool >> 32));
+
+    SSE_RM(a, MOVDQA_LOAD, STATE0, RAX, SHA256_JIT_POOL_H0);
+    SSE_RM(a, MOVDQA_LOAD, STATE1, RAX, SHA256_JIT_POOL_H0 + 16);
+    SSE_RM(a, MOVDQA_LOAD, MASK, RAX, SHA256_JIT_POOL_MASK);
+
+    // Full blocks, a single block goes without loop
+    if(N == 1){
+        sha256_jit_emit_block(a, RSI, 0);
+        sha256_jit_emit8(a, 0x48); // add rsi, 64
+        sha256_jit_emit8(a, 0x83);
+        sha256_jit_emit8(a, 0xC6);
+        sha256_jit_emit8(a, 64);
+    }
+    if(N > 1){
+        sha256_jit_emit8(a, 0xB9); // mov ecx, N
+        sha256_jit_emit32(a, N);
+        loop = a->size;
+        sha256_jit_emit_block(a, RSI, 0);
+        sha256_jit_emit8(a, 0x48); // add rsi, 64
+        sha256_jit_emit8(a, 0x83);
+        sha256_jit_emit8(a, 0xC6);
+        sha256_jit_emit8(a, 64);
+        sha256_jit_emit8(a, 0xFF); // dec ecx
+        sha256_jit_emit8(a, 0xC9);
+        sha256_jit_emit8(a, 0x0F); // jnz loop
+        sha256_jit_emit8(a, 0x85);
+        sha256_jit_emit32(a, (uint32_t) (int32_t) (loop - (a->size + 4)));
+    }
+
+    // Padding block with the message tail, assembled from the pool and R copied bytes
+    if(R > 0){
+        for(i=0; i<4; i++){
+            SSE_RM(a, MOVDQA_LOAD, TMP, RAX, SHA256_JIT_POOL_TAIL + 16*i);
+            SSE_RM(a, MOVDQU_STORE, TMP, RSP, 16*i - 64);
+        }
+        sha256_jit_emit_copy_tail(a, R);
+        sha256_jit_emit_block(a, RSP, -64);
+    }
+
+    // Padding block without message bytes
+    if(R == 0 || R >= 56) sha256_jit_emit_const_block(a);
+
+    // Reorder back to DCBA, HGFE and store
+    SSE_RRI(a, PSHUFD, STATE0, STATE0, 0x1B);
+    SSE_RRI(a, PSHUFD, STATE1, STATE1, 0xB1);
+    SSE_RR(a, MOVDQA_LOAD, TMP, STATE0);
+    SSE_RRI(a, PBLENDW, TMP, STATE1, 0xF0);
+    SSE_RRI(a, PALIGNR, STATE1, STATE0, 8);
+    SSE_RM(a, MOVDQU_STORE, TMP, RDI, 0);
+    SSE_RM(a, MOVDQU_STORE, STATE1, RDI, 16);
+    sha256_jit_emit8(a, 0xC3); // ret
+}
+
+/* Append the function to the perf map of this process */
+static void
+sha256_jit_write_perf_map(const void* code, size_t size, unsigned int msg_len){
+    char path[64];
+    FILE* perf_map;
+
+    if(!getenv("VOLK_SHA256_PERF_MAP")) return;
+    snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int) getpid());
+    perf_map = fopen(path, "a");
+    if(!perf_map) return;
+    fprintf(perf_map, "%lx %lx volk_sha256_jit_hash_%u\n", (unsigned long) (uintptr_t) code, (unsigned long) size, msg_len);
+    fclose(perf_map);
+}
+
+/* Generate the function for msg_len bytes and publish it in the index, called with the lock held */
+static int
+sha256_jit_compile_locked(unsigned int msg_len)
+{
+    sha256_jit_asm_t a;
+    uint8_t* map;
+    unsigned int i;
+
+    if(volk_sha256_jit_get(msg_len)) return 0;
+    if(sha256_jit_n_maps == SHA256_JIT_MAX_FUNCS) return -1;
+    volk_sha256_cpu_init();
+    if(!volk_sha256_cpu.has_sha() || !volk_sha256_cpu.has_sse4_1()) return -1;
+
+    // Write the pool and code, then turn the mapping executable and read only
+    map = (uint8_t*) mmap(NULL, SHA256_JIT_MAP_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(map == MAP_FAILED) return -1;
+    sha256_jit_fill_pool(map, msg_len);
+    a.code = map + SHA256_JIT_CODE_OFFSET;
+    a.size = 0;
+    a.capacity = SHA256_JIT_MAP_SIZE - SHA256_JIT_CODE_OFFSET;
+    sha256_jit_emit_func(&a, map, msg_len);
+    if(a.size > a.capacity || mprotect(map, SHA256_JIT_MAP_SIZE, PROT_READ | PROT_EXEC)){
+        munmap(map, SHA256_JIT_MAP_SIZE);
+        return -1;
+    }
+    sha256_jit_write_perf_map(a.code, a.size, msg_len);
+    sha256_jit_maps[sha256_jit_n_maps++] = map;
+
+    // Publish the slot after it is complete
+    i = sha256_jit_slot(msg_len);
+    while(sha256_jit_index[i].used) i = (i + 1) & (SHA256_JIT_INDEX_SIZE - 1);
+    sha256_jit_index[i].msg_len = msg_len;
+    sha256_jit_index[i].func = (volk_sha256_jit_func_t) (uintptr_t) a.code;
+    __atomic_store_n(&sha256_jit_index[i].used, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int volk_sha256_jit_compile(unsigned int msg_len)
+{
+    int ret;
+
+    pthread_mutex_lock(&sha256_jit_lock);
+    ret = sha256_jit_compile_locked(msg_len);
+    pthread_mutex_unlock(&sha256_jit_lock);
+    return ret;
+}
+
+void volk_sha256_jit_free(void)
+{
+    unsigned int i;
+
+    pthread_mutex_lock(&sha256_jit_lock);
+    for(i=0; i<SHA256_JIT_INDEX_SIZE; i++) __atomic_store_n(&sha256_jit_index[i].used, 0, __ATOMIC_RELAXED);
+    for(i=0; i<sha256_jit_n_maps; i++) munmap(sha256_jit_maps[i], SHA256_JIT_MAP_SIZE);
+    sha256_jit_n_maps = 0;
+    pthread_mutex_unlock(&sha256_jit_lock);
+}
+
+#else /* VOLK_SHA256_JIT_SUPPORTED */
+
+volk_sha256_jit_func_t volk_sha256_jit_get(unsigned int msg_len)
+{
+    (void) msg_len;
+    return NULL;
+}
+
+int volk_sha256_jit_compile(unsigned int msg_len)
+{
+    (void) msg_len;
+    return -1;
+}
+
+void volk_sha256_jit_free(void)
+{
+}
+
+#endif /* VOLK_SHA256_JIT_SUPPORTED */
@@ -0,0 +1,55 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <volk_sha256/volk_sha256_pbkdf2.h>
+#include <volk_sha256/volk_sha256.h>
+#include <volk_sha256/volk_sha256_8u_pbkdf2_8u.h>
+
+/* Number of passwords whose key states are gathered at once */
+#define VOLK_SHA256_PBKDF2_CHUNK 64
+
+int volk_sha256_pbkdf2(uint8_t* dk, unsigned int dk_len, const uint8_t* password, unsigned int password_len,
+                       const uint8_t* salt, unsigned int salt_len, unsigned int iterations)
+{
+    volk_sha256_hmac_key_t key;
+    const volk_sha256_hmac_key_t* keys = &key;
+
+    volk_sha256_hmac_key_init(&key, password, password_len);
+    return volk_sha256_pbkdf2_batch(dk, dk_len, &keys, &salt, &salt_len, iterations, 1);
+}
+
+int volk_sha256_pbkdf2_batch(uint8_t* dk, unsigned int dk_len, const volk_sha256_hmac_key_t* const* passwords,
+                             const uint8_t* const* salts, const unsigned int* salt_lens,
+                             unsigned int iterations, unsigned int count)
+{
+    const uint32_t* key_states[VOLK_SHA256_PBKDF2_CHUNK];
+    unsigned int i, j, n;
+
+    if(iterations == 0) return -1;
+
+    for(i = 0; i < count; i += n) {
+        n = (count - i < VOLK_SHA256_PBKDF2_CHUNK) ? count - i : VOLK_SHA256_PBKDF2_CHUNK;
+        for(j = 0; j < n; j++) key_states[j] = passwords[i + j]->state;
+        volk_sha256_8u_pbkdf2_8u(dk + (size_t) dk_len * i, key_states, salts + i, salt_lens + i, iterations, dk_len, n);
+    }
+    return 0;
+}
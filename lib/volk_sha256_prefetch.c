@@ -0,0 +1,40 @@
+/* -*- c -*- */
+/*
+ * Copyright 2015 Stefan Wunsch
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <volk_sha256/volk_sha256_prefetch.h>
+#include <volk_sha256/volk_sha256_prefs.h>
+
+static unsigned int prefetch_distance;
+static int prefetch_distance_set = 0;
+
+unsigned int volk_sha256_get_prefetch_distance(void)
+{
+    if(prefetch_distance_set) return prefetch_distance;
+    return volk_sha256_get_config()->prefetch_distance;
+}
+
+void volk_sha256_set_prefetch_distance(unsigned int distance)
+{
+    // round up to whole cache lines, a distance below one line must not turn prefetching off
+    prefetch_distance = (distance > ~63u) ? ~63u : (distance + 63u) & ~63u;
+    prefetch_distance_set = 1;
+}
@@ -2,6 +2,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <volk_sha256/volk_sha256_prefs.h>
+#include <volk_sha256/volk_sha256_prefetch.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/* Config line holding the prefetch distance in bytes of the large input implementations */
+#define VOLK_SHA256_PREFETCH_DISTANCE_KEY "prefetch_distance"
 
 void volk_sha256_get_config_path(char *path)
 {
@@ -18,10 +27,11 @@ void volk_sha256_get_config_path(char *path)
     strcat(path, suffix);
 }
 
-size_t volk_sha256_load_preferences(volk_sha256_arch_pref_t **prefs_res)
+static size_t volk_sha256_read_config(volk_sha256_arch_pref_t **prefs_res, unsigned int *prefetch_distance)
 {
     FILE *config_file;
-    char path[512], line[512];
+    char path[512], line[512], key[128];
+    unsigned long value;
     size_t n_arch_prefs = 0;
     volk_sha256_arch_pref_t *prefs = NULL;
 
@@ -34,6 +44,12 @@ size_t volk_sha256_load_preferences(volk_sha256_arch_pref_t **prefs_res)
     //reset the file pointer and write the prefs into volk_sha256_arch_prefs
     while(fgets(line, sizeof(line), config_file) != NULL)
     {
+        if(prefetch_distance && sscanf(line, "%127s %lu", key, &value) == 2 && !strcmp(key, VOLK_SHA256_PREFETCH_DISTANCE_KEY))
+        {
+            // round up to whole cache lines, a distance below one line must not turn prefetching off
+            *prefetch_distance = (value > ~63u) ? ~63u : ((unsigned int) value + 63u) & ~63u;
+            continue;
+        }
         prefs = (volk_sha256_arch_pref_t *) realloc(prefs, (n_arch_prefs+1) * sizeof(*prefs));
         volk_sha256_arch_pref_t *p = prefs + n_arch_prefs;
         if(sscanf(line, "%s %s %s", p->name, p->impl_a, p->impl_u) == 3 && !strncmp(p->name, "volk_sha256_", 5))
@@ -45,3 +61,40 @@ size_t volk_sha256_load_preferences(volk_sha256_arch_pref_t **prefs_res)
     *prefs_res = prefs;
     return n_arch_prefs;
 }
+
+size_t volk_sha256_load_preferences(volk_sha256_arch_pref_t **prefs_res)
+{
+    return volk_sha256_read_config(prefs_res, NULL);
+}
+
+/* The config is read on the first dispatch of any kernel and on the first hash of the _prefetch
+ * implementations, which may happen concurrently, so it is initialized exactly once */
+static volk_sha256_config_t config;
+
+static void volk_sha256_init_config(void)
+{
+    config.arch_prefs = NULL;
+    config.prefetch_distance = VOLK_SHA256_DEFAULT_PREFETCH_DISTANCE;
+    config.n_arch_prefs = volk_sha256_read_config(&config.arch_prefs, &config.prefetch_distance);
+}
+
+#if defined(_WIN32)
+static BOOL CALLBACK volk_sha256_init_config_once(PINIT_ONCE once, PVOID param, PVOID *context)
+{
+    (void) once; (void) param; (void) context;
+    volk_sha256_init_config();
+    return TRUE;
+}
+#endif
+
+const volk_sha256_config_t *volk_sha256_get_config(void)
+{
+#if defined(_WIN32)
+    static INIT_ONCE config_once = INIT_ONCE_STATIC_INIT;
+    InitOnceExecuteOnce(&config_once, volk_sha256_init_config_once, NULL, NULL);
+#else
+    static pthread_once_t config_once = PTHREAD_ONCE_INIT;
+    pthread_once(&config_once, volk_sha256_init_config);
+#endif
+    return &config;
+}
@@ -52,13 +52,9 @@ int volk_sha256_rank_archs(
 )
 {
     size_t i;
-    static volk_sha256_arch_pref_t *volk_sha256_arch_prefs;
-    static size_t n_arch_prefs = 0;
-    static int prefs_loaded = 0;
-    if(!prefs_loaded) {
-        n_arch_prefs = volk_sha256_load_preferences(&volk_sha256_arch_prefs);
-        prefs_loaded = 1;
-    }
+    const volk_sha256_config_t *config = volk_sha256_get_config();
+    const volk_sha256_arch_pref_t *volk_sha256_arch_prefs = config->arch_prefs;
+    const size_t n_arch_prefs = config->n_arch_prefs;
 
     // If we've defined VOLK_GENERIC to be anything, always return the
     // 'generic' kernel. Used in GR's QA code.
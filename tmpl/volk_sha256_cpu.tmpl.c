@@ -117,6 +117,14 @@ static inline unsigned int get_avx2_enabled(void) {
 #endif
 }
 
+static inline unsigned int get_avx512_enabled(void) {
+#if defined(VOLK_CPU_x86)
+    return (__xgetbv() & 0xE6) == 0xE6; //check for the opmask and ZMM state besides XMM and YMM
+#else
+    return 0;
+#endif
+}
+
 //neon detection is linux specific
 #if defined(__arm__) && defined(__linux__)
     #include <asm/hwcap.h>